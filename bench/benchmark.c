@@ -0,0 +1,64 @@
+// benchmark.c - Runs every engine's benchmark positions and prints the results as JSON
+//
+// Usage: benchmark [game]   (twoDTicTacToe, threeDTicTacToe, twoDConnectFour or
+//                            threeDConnectFour; all four if omitted)
+//
+// Searches run single-threaded with fresh tables and a fixed random seed, so the node
+// counts and moves are the same on every run and two outputs can be diffed directly.
+// Only times and nps depend on the machine.
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "benchmark.h"
+
+static int resultCount = 0;
+static long long totalNodes = 0;
+static double totalTimeMs = 0;
+
+double benchNowMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+void reportBench(const char *game, const char *position, int depth, long long nodes, double timeMs,
+                 const char *move) {
+    long long nps = timeMs > 0 ? (long long)(nodes * 1000.0 / timeMs) : 0;
+    printf("%s\n    {\"game\": \"%s\", \"position\": \"%s\", \"depth\": %d, \"nodes\": %lld, "
+           "\"timeMs\": %.3f, \"nps\": %lld, \"move\": \"%s\"}",
+           resultCount > 0 ? "," : "", game, position, depth, nodes, timeMs, nps, move);
+    fflush(stdout);
+    resultCount++;
+    totalNodes += nodes;
+    totalTimeMs += timeMs;
+}
+
+int main(int argc, char *argv[]) {
+    struct { const char *name; void (*run)(void); } games[] = {
+        { "twoDTicTacToe", benchTwoDTicTacToe },
+        { "threeDTicTacToe", benchThreeDTicTacToe },
+        { "twoDConnectFour", benchTwoDConnectFour },
+        { "threeDConnectFour", benchThreeDConnectFour },
+    };
+    int gameCount = sizeof(games) / sizeof(games[0]);
+    const char *only = argc > 1 ? argv[1] : NULL;
+
+    if (only != NULL) {
+        int found = 0;
+        for (int i = 0; i < gameCount; i++) found |= strcmp(games[i].name, only) == 0;
+        if (!found) {
+            fprintf(stderr, "Unknown game: %s\n", only);
+            return 1;
+        }
+    }
+
+    printf("{\n  \"results\": [");
+    for (int i = 0; i < gameCount; i++) {
+        if (only == NULL || strcmp(games[i].name, only) == 0) games[i].run();
+    }
+    long long nps = totalTimeMs > 0 ? (long long)(totalNodes * 1000.0 / totalTimeMs) : 0;
+    printf("\n  ],\n  \"totalNodes\": %lld,\n  \"totalTimeMs\": %.3f,\n  \"nps\": %lld\n}\n",
+           totalNodes, totalTimeMs, nps);
+    return 0;
+}
@@ -0,0 +1,22 @@
+// benchmark.h - Fixed-depth node count and speed benchmark for all four engines
+//
+// Each game's positions live in their own translation unit (<game>Bench.c), because
+// the engine headers define clashing macros (SIZE, EMPTY, ROWS, COLS, ...). They call
+// the game's normal search entry point at a fixed depth and hand every result to
+// reportBench, which writes it as JSON.
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+double benchNowMs(void);
+
+// One searched position. move uses the text protocol's notation (see README).
+void reportBench(const char *game, const char *position, int depth, long long nodes, double timeMs,
+                 const char *move);
+
+void benchTwoDTicTacToe(void);
+void benchThreeDTicTacToe(void);
+void benchTwoDConnectFour(void);
+void benchThreeDConnectFour(void);
+
+#endif // BENCHMARK_H
@@ -0,0 +1,47 @@
+// threeDConnectFourBench.c - Benchmark positions for 4x4x4 Sogo (getBestMove3D at a fixed depth)
+//
+// The positions have no immediate win or block and no open three for the AI, so
+// getBestMove3D always runs its full alpha-beta search rather than a shortcut.
+
+#include <stdio.h>
+#include <string.h>
+#include "../engine/threeDConnectFourEngine.h"
+#include "benchmark.h"
+
+// Columns as "rc" pairs played from the empty board; pieces alternate so that AI is to move
+static const struct { const char *name; const char *moves; int depth; } positions[] = {
+    { "empty", "", 9 },
+    { "center", "11", 9 },
+    { "opening", "11 22 12", 9 },
+    { "midgame", "11 22 12 21 00 33 11 22", 9 },
+};
+
+void benchThreeDConnectFour(void) {
+    int savedThreads = searchThreads3D;
+    searchThreads3D = 1; // Lazy SMP helpers would make the node counts vary between runs
+    initLines3D();
+    initZobrist3D();
+    for (size_t p = 0; p < sizeof(positions) / sizeof(positions[0]); p++) {
+        Board3D board;
+        resetBoard3D(&board);
+        int count = (int)(strlen(positions[p].moves) + 1) / 3;
+        for (int i = 0; i < count; i++) {
+            const char *m = positions[p].moves + 3 * i;
+            makeMove3D(&board, m[0] - '0', m[1] - '0', (count - i) % 2 == 0 ? AI : PLAYER);
+        }
+
+        initTT3D(TT_DEFAULT_SIZE_LOG2); // A fresh table, so earlier positions do not help
+        difficulty3D = positions[p].depth;
+        moveTimeMs3D = 1000 * 1000 * 1000; // Depth is the only limit
+        int r, c;
+        double startMs = benchNowMs();
+        getBestMove3D(&board, &r, &c);
+        double timeMs = benchNowMs() - startMs;
+
+        char move[16];
+        snprintf(move, sizeof(move), "%d%d", r, c);
+        reportBench("threeDConnectFour", positions[p].name, positions[p].depth, searchStats3D.nodes, timeMs, move);
+    }
+    freeTT3D();
+    searchThreads3D = savedThreads;
+}
@@ -0,0 +1,39 @@
+// threeDTicTacToeBench.c - Benchmark positions for 3D Tic-Tac-Toe (GetAIMove at a fixed ply)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../engine/threeDTicTacToeEngine.h"
+#include "benchmark.h"
+
+// Moves as "lrc" triples, X first; the engine plays the side to move
+static const struct { const char *name; const char *moves; int ply; } positions[] = {
+    { "empty", "", 4 },
+    { "center", "111", 4 },
+    { "center-corner", "111 000", 4 },
+    { "midgame", "111 000 222 020", 5 },
+};
+
+void benchThreeDTicTacToe(void) {
+    char board[SIZE][SIZE][SIZE];
+    for (size_t p = 0; p < sizeof(positions) / sizeof(positions[0]); p++) {
+        InitializeBoard3D(board);
+        char side = 'X';
+        for (const char *m = positions[p].moves; *m != '\0'; m += (m[3] == ' ') ? 4 : 3) {
+            board[m[0] - '0'][m[1] - '0'][m[2] - '0'] = side;
+            side = (side == 'X') ? 'O' : 'X';
+        }
+        AI_SYMBOL = side;
+        USER_SYMBOL = (side == 'X') ? 'O' : 'X';
+
+        srand(1); // GetAIMove picks among equal moves at random
+        SearchStats stats;
+        int layer, row, col;
+        double startMs = benchNowMs();
+        GetAIMove(board, positions[p].ply, &stats, &layer, &row, &col);
+        double timeMs = benchNowMs() - startMs;
+
+        char move[16];
+        snprintf(move, sizeof(move), "%d%d%d", layer, row, col);
+        reportBench("threeDTicTacToe", positions[p].name, positions[p].ply + 1, stats.nodes, timeMs, move);
+    }
+}
@@ -0,0 +1,44 @@
+// twoDConnectFourBench.c - Benchmark positions for 7x6 Connect Four (getBestMove2D at a fixed depth)
+
+#include <stdio.h>
+#include <string.h>
+#include "../engine/twoDConnectFourEngine.h"
+#include "benchmark.h"
+
+// Columns played from the empty board; pieces alternate so that AI is to move
+static const struct { const char *name; const char *moves; int depth; } positions[] = {
+    { "empty", "", 16 },
+    { "center", "3", 15 },
+    { "opening", "3 3 2 4", 16 },
+    { "midgame", "3 3 3 3 2 4 4 2 5 1", 20 },
+};
+
+void benchTwoDConnectFour(void) {
+    int savedThreads = searchThreads;
+    searchThreads = 1; // Parallel root search would make the node counts vary between runs
+    initZobrist2D();
+    initTT2D(TT_DEFAULT_SIZE_LOG2);
+    for (size_t p = 0; p < sizeof(positions) / sizeof(positions[0]); p++) {
+        Board2D board;
+        memset(&board, 0, sizeof(board));
+        int count = (int)(strlen(positions[p].moves) + 1) / 2;
+        for (int i = 0; i < count; i++) {
+            makeMove2D(&board, positions[p].moves[2 * i] - '0', (count - i) % 2 == 0 ? AI : PLAYER);
+        }
+
+        clearTT2D();
+        difficulty2D = positions[p].depth;
+        moveTimeMs2D = 1000 * 1000 * 1000; // Depth is the only limit
+        SearchProgress2D progress = { 0 };
+        double startMs = benchNowMs();
+        int col = getBestMove2D(&board, &progress);
+        double timeMs = benchNowMs() - startMs;
+
+        char move[16];
+        snprintf(move, sizeof(move), "%d", col);
+        reportBench("twoDConnectFour", positions[p].name, positions[p].depth + 1,
+                    progress.stats.nodes, timeMs, move);
+    }
+    freeTT2D();
+    searchThreads = savedThreads;
+}
@@ -0,0 +1,42 @@
+// twoDTicTacToeBench.c - Benchmark positions for 2D Tic-Tac-Toe (FindBestMove at hard)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../engine/twoDTicTacToeEngine.h"
+#include "benchmark.h"
+
+// Moves as "rc" pairs, X first; the engine plays the side to move
+static const struct { const char *name; const char *moves; } positions[] = {
+    { "empty", "" },
+    { "corner", "00" },
+    { "center-corner", "11 00" },
+    { "edge-opening", "01 11 21" },
+    { "midgame", "00 11 22 02" },
+};
+
+void benchTwoDTicTacToe(void) {
+    difficulty = 3; // Full-depth search
+    for (size_t p = 0; p < sizeof(positions) / sizeof(positions[0]); p++) {
+        InitializeBoard();
+        char side = 'X';
+        int empties = NUM_CELLS;
+        for (const char *m = positions[p].moves; *m != '\0'; m += (m[2] == ' ') ? 3 : 2) {
+            board[m[0] - '0'][m[1] - '0'] = side;
+            side = (side == 'X') ? 'O' : 'X';
+            empties--;
+        }
+        aiSymbol = side;
+        playerSymbol = (side == 'X') ? 'O' : 'X';
+
+        srand(1); // FindBestMove picks among equal moves at random
+        int row, col;
+        double startMs = benchNowMs();
+        FindBestMove(&row, &col);
+        double timeMs = benchNowMs() - startMs;
+
+        char move[16];
+        snprintf(move, sizeof(move), "%d%d", row, col);
+        int depth = empties < 10 ? empties : 10; // The AI's move plus hard's 9 plies, up to a full board
+        reportBench("twoDTicTacToe", positions[p].name, depth, searchStats.nodes, timeMs, move);
+    }
+}
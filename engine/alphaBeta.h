@@ -0,0 +1,186 @@
+// alphaBeta.h - Shared alpha-beta search core for all four games
+//
+// A "template" in plain C: a game describes itself with the macros below and then
+// includes this file, which expands into one fail-soft alpha-beta function for that
+// game. Every hook is a macro, so the game's own code is inlined into the search and
+// nothing is looked up at run time. Including it without AB_NAME defined only declares
+// the shared types below; each include with AB_NAME defined generates one function,
+// and all parameters are #undef'd again at the end.
+//
+// Scores are always from the maximizing side's (the AI's) point of view, and `depth`
+// is the number of plies left. The generated function is
+//
+//     int AB_NAME(AB_STATE *s, int depth, int alpha, int beta, bool maximizing);
+//
+// Required:
+//   AB_NAME                       Name of the generated function
+//   AB_STATE                      Search context type; holds the position
+//   AB_MAX_MOVES                  Upper bound on the moves in one position
+//   AB_TERMINAL(s, depth, out)    If the node is decided (win, loss, draw) or at the
+//                                 horizon: store its score in *out, return true
+//   AB_GEN_MOVES(s, depth, maximizing, ttMove, moves)
+//                                 Fill moves[] best first, return the count. ttMove
+//                                 is the table's best move, or -1
+//   AB_MAKE(s, move, maximizing)  Play a move; true if it wins on the spot
+//   AB_UNDO(s, move, maximizing)  Take it back
+//
+// Optional:
+//   AB_MOVE_WIN_SCORE(s, depth)   Score (for the mover, positive) of a move that AB_MAKE
+//                                 reported as winning, at a node with `depth` plies left
+//   AB_ENTER(s)                   Called on entry; true unwinds (node counting, clocks)
+//   AB_ABORTED(s)                 Checked after every child; true unwinds. Results
+//                                 returned while unwinding are meaningless
+//   AB_ADJUST_WINDOW(s, alpha, beta)
+//                                 May narrow the window before the table is probed
+//   AB_PV_UPDATE(s, move, searched)
+//                                 Called after AB_UNDO when a move raises alpha (maximizing)
+//                                 or lowers beta (minimizing), to collect the principal
+//                                 variation. searched is false if the move won on the spot,
+//                                 so there is no child line to append
+//   AB_STATS(s)                   SearchStats * (searchInfo.h) in which to count leaf
+//                                 evaluations, beta cutoffs (and those by the first move),
+//                                 table probes and hits. Nodes and depth are up to the game
+//   AB_TT_KEY_TYPE, AB_TT_KEY(s)  Transposition table key. With these defined:
+//   AB_TT_PROBE(s, key, depth, hit)
+//                                 Fill *hit (an AlphaBetaHit, score relative to this
+//                                 node) and return true if the table has the position
+//   AB_TT_STORE(s, key, depth, score, bound, move)
+//                                 Store a result; bound is an AB_BOUND_* value
+
+#ifndef ALPHA_BETA_H
+#define ALPHA_BETA_H
+
+#include <limits.h>
+#include <stdbool.h>
+
+// What a stored score says about the true value
+#define AB_BOUND_EXACT 1 // Score is the exact minimax value
+#define AB_BOUND_LOWER 2 // Search failed high: true value >= score
+#define AB_BOUND_UPPER 3 // Search failed low: true value <= score
+
+typedef struct {
+    int score; // Relative to the probing node
+    int depth; // Plies the stored search looked ahead
+    int bound; // AB_BOUND_*
+    int move;  // Best move found, or -1
+} AlphaBetaHit;
+
+#endif // ALPHA_BETA_H
+
+#ifdef AB_NAME
+
+#ifndef AB_MOVE_WIN_SCORE
+#define AB_MOVE_WIN_SCORE(s, depth) 0
+#endif
+#ifndef AB_ENTER
+#define AB_ENTER(s) false
+#endif
+#ifndef AB_ABORTED
+#define AB_ABORTED(s) false
+#endif
+#ifndef AB_ADJUST_WINDOW
+#define AB_ADJUST_WINDOW(s, alpha, beta) ((void)0)
+#endif
+#ifndef AB_PV_UPDATE
+#define AB_PV_UPDATE(s, move, searched) ((void)0)
+#endif
+#ifdef AB_STATS
+#define AB_COUNT(s, counter) (AB_STATS(s)->counter++)
+#else
+#define AB_COUNT(s, counter) ((void)0)
+#endif
+
+int AB_NAME(AB_STATE *s, int depth, int alpha, int beta, bool maximizing) {
+    if (AB_ENTER(s)) return 0; // Unwinding: the value is discarded by the caller
+
+    int terminalScore;
+    if (AB_TERMINAL(s, depth, &terminalScore)) {
+        AB_COUNT(s, leafEvals);
+        return terminalScore;
+    }
+
+    AB_ADJUST_WINDOW(s, alpha, beta);
+
+    int ttMove = -1;
+#ifdef AB_TT_KEY_TYPE
+    AB_TT_KEY_TYPE key = AB_TT_KEY(s);
+    AlphaBetaHit hit;
+    AB_COUNT(s, ttProbes);
+    if (AB_TT_PROBE(s, key, depth, &hit)) {
+        AB_COUNT(s, ttHits);
+        ttMove = hit.move;
+        if (hit.depth >= depth) {
+            if (hit.bound == AB_BOUND_EXACT) return hit.score;
+            if (hit.bound == AB_BOUND_LOWER && hit.score > alpha) alpha = hit.score;
+            if (hit.bound == AB_BOUND_UPPER && hit.score < beta) beta = hit.score;
+            if (beta <= alpha) return hit.score;
+        }
+    }
+    // Bound type of the result is decided against the window actually searched
+    int alphaSearched = alpha, betaSearched = beta;
+#endif
+
+    int moves[AB_MAX_MOVES];
+    int moveCount = AB_GEN_MOVES(s, depth, maximizing, ttMove, moves);
+    int bestMove = -1;
+    int bestEval = maximizing ? INT_MIN : INT_MAX;
+
+    for (int m = 0; m < moveCount; m++) {
+        int eval;
+        bool won = AB_MAKE(s, moves[m], maximizing);
+        if (won) {
+            int winScore = AB_MOVE_WIN_SCORE(s, depth);
+            eval = maximizing ? winScore : -winScore;
+        } else {
+            eval = AB_NAME(s, depth - 1, alpha, beta, !maximizing);
+        }
+        AB_UNDO(s, moves[m], maximizing);
+        if (AB_ABORTED(s)) return 0;
+        if (maximizing ? eval > alpha : eval < beta) AB_PV_UPDATE(s, moves[m], !won);
+
+        if (maximizing ? eval > bestEval : eval < bestEval) {
+            bestEval = eval;
+            bestMove = moves[m];
+        }
+        if (maximizing) {
+            if (eval > alpha) alpha = eval;
+        } else {
+            if (eval < beta) beta = eval;
+        }
+        if (beta <= alpha) { // The other side already has a better option elsewhere
+            AB_COUNT(s, betaCutoffs);
+            if (m == 0) AB_COUNT(s, firstMoveCutoffs);
+            break;
+        }
+    }
+
+#ifdef AB_TT_KEY_TYPE
+    int bound = bestEval <= alphaSearched ? AB_BOUND_UPPER
+              : bestEval >= betaSearched  ? AB_BOUND_LOWER
+              : AB_BOUND_EXACT;
+    AB_TT_STORE(s, key, depth, bestEval, bound, bestMove);
+#endif
+    (void)ttMove; (void)bestMove; // Unused by games without a table
+    return bestEval;
+}
+
+#undef AB_NAME
+#undef AB_STATE
+#undef AB_MAX_MOVES
+#undef AB_TERMINAL
+#undef AB_GEN_MOVES
+#undef AB_MAKE
+#undef AB_UNDO
+#undef AB_MOVE_WIN_SCORE
+#undef AB_ENTER
+#undef AB_ABORTED
+#undef AB_ADJUST_WINDOW
+#undef AB_PV_UPDATE
+#undef AB_STATS
+#undef AB_COUNT
+#undef AB_TT_KEY_TYPE
+#undef AB_TT_KEY
+#undef AB_TT_PROBE
+#undef AB_TT_STORE
+
+#endif // AB_NAME
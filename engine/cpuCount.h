@@ -0,0 +1,25 @@
+// cpuCount.h - Number of online CPUs, for sizing the search threads
+//
+// Header-only. On Windows it asks winpthreads (the build already links -lpthread)
+// rather than GetSystemInfo, because <windows.h> clashes with raylib's names.
+
+#ifndef CPU_COUNT_H
+#define CPU_COUNT_H
+
+#ifdef _WIN32
+#include <pthread.h> // For pthread_num_processors_np
+#else
+#include <unistd.h> // For sysconf
+#endif
+
+// Online CPUs, clamped to [1, maxThreads]
+static inline int onlineCpuCount(int maxThreads) {
+#ifdef _WIN32
+    long cpus = pthread_num_processors_np();
+#else
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return cpus < 1 ? 1 : cpus > maxThreads ? maxThreads : (int)cpus;
+}
+
+#endif // CPU_COUNT_H
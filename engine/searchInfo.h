@@ -0,0 +1,59 @@
+// searchInfo.h - Search limits and per-iteration reports shared by all four engines
+//
+// Each engine has a limited search entry point (FindBestMoveLimited, GetAIMoveLimited,
+// getBestMove2DLimited, getBestMove3DLimited) that deepens one ply at a time until a
+// limit is hit and reports every finished iteration through a SearchInfoCallback.
+// Moves in a report use the engine's own encoding: the flat cell index for the
+// Tic-Tac-Toe games, the column for Connect Four and r * COLS + c for Sogo.
+
+#ifndef SEARCH_INFO_H
+#define SEARCH_INFO_H
+
+#define SEARCH_MAX_PV 64
+
+// What a caller allows one search. 0 means no limit; depth is then capped by the
+// number of empty cells. A search stopped by a limit plays its last finished iteration.
+typedef struct {
+    int depth;       // Plies, counting the side to move's own move
+    long long nodes;
+    double timeMs;
+} SearchLimits;
+
+// One finished iteration, from the side to move's point of view
+typedef struct {
+    int depth;             // Plies searched
+    int score;             // In the engine's own units; wins are the largest scores
+    long long nodes;       // Since the search started
+    double timeMs;         // Since the search started
+    int pvLength;
+    int pv[SEARCH_MAX_PV]; // Expected line, starting with the move to play
+} SearchInfo;
+
+typedef void (*SearchInfoCallback)(const SearchInfo *info, void *ctx);
+
+// Work done by one AI move, for the front ends' statistics overlay and log. The
+// counters marked (alphaBeta.h) are kept by the shared core through its AB_STATS hook;
+// each engine adds the rest. All zero when the move came from a shortcut or a table.
+typedef struct {
+    long long nodes;
+    long long leafEvals;        // Nodes scored without expanding them (alphaBeta.h)
+    long long betaCutoffs;      // Move loops left early (alphaBeta.h)
+    long long firstMoveCutoffs; // ... by the first move tried (alphaBeta.h)
+    long long ttProbes;         // (alphaBeta.h)
+    long long ttHits;           // (alphaBeta.h)
+    int maxDepth;               // Deepest ply reached, the AI's own move being ply 1
+    double timeMs;              // Wall clock for the whole move
+} SearchStats;
+
+// Adds one thread's or one root move's counters; timeMs is left alone
+static inline void addSearchStats(SearchStats *total, const SearchStats *part) {
+    total->nodes += part->nodes;
+    total->leafEvals += part->leafEvals;
+    total->betaCutoffs += part->betaCutoffs;
+    total->firstMoveCutoffs += part->firstMoveCutoffs;
+    total->ttProbes += part->ttProbes;
+    total->ttHits += part->ttHits;
+    if (part->maxDepth > total->maxDepth) total->maxDepth = part->maxDepth;
+}
+
+#endif // SEARCH_INFO_H
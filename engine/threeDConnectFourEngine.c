@@ -0,0 +1,861 @@
+// threeDConnectFourEngine.c - Board, rules and AI for Sogo (no raylib)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <time.h>
+#include <float.h> // For DBL_MAX
+#include <pthread.h>
+#include <stdatomic.h>
+#include "threeDConnectFourEngine.h"
+#include "alphaBeta.h" // Shared search core
+
+// Global variables
+int difficulty3D = 4; // Default AI depth cap (will be set by user)
+int moveTimeMs3D = 500; // Wall-clock budget per AI move; the last fully searched depth is played
+Line3D lines3D[NUM_LINES3D]; // Filled once by initLines3D
+unsigned char cellLines3D[NUM_CELLS3D][MAX_CELL_LINES3D]; // Lines through each cell
+int cellLineCount3D[NUM_CELLS3D];
+
+// symColumn3D[s][col] is where symmetry s sends column col (r * COLS + c);
+// symInverse3D[s] undoes it. The empty board hashes to 0 under every symmetry.
+int symColumn3D[NUM_SYMMETRIES3D][ROWS * COLS];
+int symInverse3D[NUM_SYMMETRIES3D][ROWS * COLS];
+uint64_t zobrist3D[3][NUM_CELLS3D];
+// Part of every hash while PLAYER is to move. Positions with as many AI as PLAYER
+// stones occur with either side to move, depending on who went first.
+uint64_t zobristSide3D;
+
+// Transposition table bound types
+#define TT_EMPTY 0 // Slot has never been written
+#define TT_EXACT AB_BOUND_EXACT
+#define TT_LOWER AB_BOUND_LOWER
+#define TT_UPPER AB_BOUND_UPPER
+
+// One entry serves all symmetric variants of a position: it is keyed by the
+// canonical (smallest) of the eight hashes and the best move is stored in the
+// canonical frame. The table lives for the whole session; age marks the game
+// an entry was written in so entries from earlier games are replaced first.
+typedef struct {
+    int score;    // Win scores are stored relative to this node (see scoreToTT3D)
+    int depth;    // Remaining depth the score was searched to
+    int flag;     // TT_EXACT / TT_LOWER / TT_UPPER
+    int bestMove; // Best column, -1 if none (canonical frame in the table, caller's frame once probed)
+    int age;
+} TTEntry3D;
+
+// Table slots are shared by all search threads without locks. The entry is
+// packed into one word and the key is stored XORed with it, so a slot torn by
+// two concurrent writers fails the key check instead of returning mixed data.
+typedef struct {
+    _Atomic uint64_t keyXorData;
+    _Atomic uint64_t data;
+} TTSlot3D;
+
+TTSlot3D *tt3D = NULL; // Search runs without a table if this is NULL
+uint64_t ttMask3D = 0;
+unsigned char ttAge3D = 0;
+
+int searchThreads3D = 1; // Main search thread plus helpers; set from the CPU count at startup
+SearchStats searchStats3D; // Work of the last getBestMove3D(Limited), all threads
+
+// Shared by all threads working on one AI move
+typedef struct {
+    double startMs;
+    double deadlineMs;
+    long long maxNodes;     // 0 for no node limit
+    atomic_llong nodes;     // All threads' nodes, published every TIME_CHECK_INTERVAL
+    atomic_bool stop;       // Set once a limit is hit or the main thread is done; every thread unwinds
+    int maxDepth;           // Iterative deepening limit for this move
+    SearchInfoCallback onInfo; // Told about each iteration the main thread finishes, may be NULL
+    void *onInfoCtx;
+} SearchShared3D;
+
+// Per-thread search state: a private copy of the position plus counters
+typedef struct {
+    Board3D pos;
+    int rootMoves;          // Pieces on the board at the root, to tell the ply of a node
+    long long nodes;
+    SearchStats stats;
+    int id;                 // 0 is the main thread, whose result is played
+    int bestCol;            // Best root move of the last finished iteration
+    int bestScore;
+    int completedDepth;
+    SearchShared3D *shared;
+} Search3D;
+
+// Proof-number endgame solver (see solveWin3D), used from Medium up
+#define PN_MIN_STONES 30       // From here on the solver is tried before every search
+#define PN_MAX_NODES (1 << 20) // Node pool cap: 2^20 nodes * 20 bytes = 20 MB
+#define PN_TIME_SHARE 4        // The solver may use 1/PN_TIME_SHARE of the move time
+
+int searchRoot3D(Search3D *s, int depth, int pvMove, int *bestScore);
+int minimax3D(Search3D *s, int depth, int alpha, int beta, bool maximizing);
+int orderMoves3D(Board3D *b, int piece, int depth, int ttMove, int moves[ROWS * COLS]);
+
+// ----------------------- 3D CONNECT 4 SECTION -----------------------
+
+// The 13 line directions (dh, dr, dc) that point upwards or stay level; the
+// opposite directions give the same lines walked from the other end
+static const int LINE_DIRECTIONS3D[13][3] = {
+    // Within a plane (h constant)
+    {0, 0, 1}, {0, 1, 0}, {0, 1, 1}, {0, 1, -1},
+    // Vertical columns
+    {1, 0, 0},
+    // Diagonals involving height change
+    {1, 0, 1}, {1, 0, -1}, {1, 1, 0}, {1, -1, 0},
+    {1, 1, 1}, {1, 1, -1}, {1, -1, 1}, {1, -1, -1}
+};
+
+// Builds the 76 line masks and the per-cell line lists. Called once at startup.
+void initLines3D() {
+    int count = 0;
+    memset(cellLineCount3D, 0, sizeof(cellLineCount3D));
+    for (int h = 0; h < HEIGHT; ++h) {
+        for (int r = 0; r < ROWS; ++r) {
+            for (int c = 0; c < COLS; ++c) {
+                for (int i = 0; i < 13; ++i) {
+                    int dh = LINE_DIRECTIONS3D[i][0];
+                    int dr = LINE_DIRECTIONS3D[i][1];
+                    int dc = LINE_DIRECTIONS3D[i][2];
+                    if (h + 3 * dh < 0 || h + 3 * dh >= HEIGHT ||
+                        r + 3 * dr < 0 || r + 3 * dr >= ROWS ||
+                        c + 3 * dc < 0 || c + 3 * dc >= COLS) continue;
+
+                    Line3D *line = &lines3D[count];
+                    line->mask = 0;
+                    for (int k = 0; k < 4; ++k) {
+                        int cell = CELL3D(h + k * dh, r + k * dr, c + k * dc);
+                        line->cells[k] = (unsigned char)cell;
+                        line->mask |= BIT3D(cell);
+                        cellLines3D[cell][cellLineCount3D[cell]++] = (unsigned char)count;
+                    }
+                    count++;
+                }
+            }
+        }
+    }
+}
+
+void resetBoard3D(Board3D *b) {
+    memset(b, 0, sizeof(*b));
+}
+
+// Value of an open line to its owner by stone count. Lines holding both colours are dead,
+// and a completed line counts 0 here because the search scores the win itself.
+static const int LINE_SCORE3D[5] = { 0, 1, 10, 100, 0 };
+
+// Contribution of a line with 'ai' AI stones and 'player' PLAYER stones to Board3D.eval
+static int lineValue3D(int ai, int player) {
+    if (ai > 0 && player > 0) return 0;
+    return LINE_SCORE3D[ai] - LINE_SCORE3D[player];
+}
+
+// Adds (delta = 1) or removes (delta = -1) a 'piece' stone on 'cell' in the line counts
+// and moves b->eval along with them. Touches only the lines through the cell.
+static void updateLines3D(Board3D *b, int cell, int piece, int delta) {
+    unsigned char *aiCount = b->lineCount[AI];
+    unsigned char *playerCount = b->lineCount[PLAYER];
+    for (int i = 0; i < cellLineCount3D[cell]; ++i) {
+        int l = cellLines3D[cell][i];
+        b->eval -= lineValue3D(aiCount[l], playerCount[l]);
+        b->lineCount[piece][l] += delta;
+        b->eval += lineValue3D(aiCount[l], playerCount[l]);
+    }
+}
+
+// Toggles a 'piece' stone at height h of column col in all eight symmetric hashes
+static void updateHash3D(Board3D *b, int h, int col, int piece) {
+    for (int s = 0; s < NUM_SYMMETRIES3D; s++) {
+        b->hash[s] ^= zobrist3D[piece][h * ROWS * COLS + symColumn3D[s][col]];
+    }
+}
+
+// Flips the side to move in all eight symmetric hashes
+static void toggleSide3D(Board3D *b) {
+    for (int s = 0; s < NUM_SYMMETRIES3D; s++) {
+        b->hash[s] ^= zobristSide3D;
+    }
+}
+
+// Piece at (h, r, c): PLAYER, AI or EMPTY
+int cellAt3D(const Board3D *b, int h, int r, int c) {
+    uint64_t bit = BIT3D(CELL3D(h, r, c));
+    if (b->stones[PLAYER] & bit) return PLAYER;
+    if (b->stones[AI] & bit) return AI;
+    return EMPTY;
+}
+
+bool isValidMove3D(const Board3D *b, int r, int c) {
+    // Check bounds first
+    if (r < 0 || r >= ROWS || c < 0 || c >= COLS) {
+        return false;
+    }
+    // Check if the column is full
+    return b->height[r * COLS + c] < HEIGHT;
+}
+
+
+int makeMove3D(Board3D *b, int r, int c, int piece) {
+    // The piece lands on top of the stack in column (r, c)
+    int h = b->height[r * COLS + c];
+    if (h >= HEIGHT) return -1; // Should not happen if isValidMove3D was checked
+    b->stones[piece] |= BIT3D(CELL3D(h, r, c));
+    b->height[r * COLS + c]++;
+    // The empty board counts as AI to move, so only PLAYER's first stone keeps the side key off
+    if (piece == AI || b->moves > 0) toggleSide3D(b);
+    b->moves++;
+    updateLines3D(b, CELL3D(h, r, c), piece, 1);
+    updateHash3D(b, h, r * COLS + c, piece);
+    return h; // Return the height where the piece was placed
+}
+
+
+void undoMove3D(Board3D *b, int r, int c) {
+    // Remove the top-most piece in the stack
+    int h = --b->height[r * COLS + c];
+    uint64_t bit = BIT3D(CELL3D(h, r, c));
+    int piece = (b->stones[AI] & bit) ? AI : PLAYER;
+    b->stones[piece] &= ~bit;
+    b->moves--;
+    if (piece == AI || b->moves > 0) toggleSide3D(b);
+    updateLines3D(b, CELL3D(h, r, c), piece, -1);
+    updateHash3D(b, h, r * COLS + c, piece);
+}
+
+// Index into lines3D of a line of four for 'piece', or -1
+int findWinningLine3D(const Board3D *b, int piece) {
+    uint64_t stones = b->stones[piece];
+    for (int i = 0; i < NUM_LINES3D; ++i) {
+        if ((stones & lines3D[i].mask) == lines3D[i].mask) return i;
+    }
+    return -1;
+}
+
+// Check for 4-in-a-row in 3D anywhere on the board
+bool winningMove3D(const Board3D *b, int piece) {
+    return findWinningLine3D(b, piece) != -1;
+}
+
+// True if the 'piece' stone just placed on 'cell' completed a line. A new line must
+// pass through the last stone, so only that cell's lines are tested.
+bool lastMoveWins3D(const Board3D *b, int cell, int piece) {
+    uint64_t stones = b->stones[piece];
+    for (int i = 0; i < cellLineCount3D[cell]; ++i) {
+        uint64_t mask = lines3D[cellLines3D[cell][i]].mask;
+        if ((stones & mask) == mask) return true;
+    }
+    return false;
+}
+
+
+// Line-potential evaluation for 3D, from the AI's side: every line still open to one
+// player scores 1, 10 or 100 for 1, 2 or 3 of their stones on it. makeMove3D and
+// undoMove3D keep the sum up to date. Only called on positions without a line of four:
+// minimax3D scores wins as soon as the winning stone is placed.
+int evaluateBoard3D(const Board3D *b) {
+     return b->eval;
+}
+
+// ----------------------- TRANSPOSITION TABLE -----------------------
+
+// splitmix64, only used to fill the Zobrist keys deterministically
+static uint64_t nextRandom64(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Fills the Zobrist keys and the symmetry tables. Call before the first move.
+void initZobrist3D() {
+    uint64_t seed = 0x536F676F3344ULL;
+    for (int p = 0; p < 3; p++)
+        for (int i = 0; i < NUM_CELLS3D; i++)
+            zobrist3D[p][i] = nextRandom64(&seed);
+    zobristSide3D = nextRandom64(&seed);
+
+    // Symmetry s: bit 2 transposes, bit 1 mirrors the rows, bit 0 mirrors the columns
+    for (int s = 0; s < NUM_SYMMETRIES3D; s++) {
+        for (int r = 0; r < ROWS; r++) {
+            for (int c = 0; c < COLS; c++) {
+                int r2 = (s & 4) ? c : r;
+                int c2 = (s & 4) ? r : c;
+                if (s & 2) r2 = ROWS - 1 - r2;
+                if (s & 1) c2 = COLS - 1 - c2;
+                symColumn3D[s][r * COLS + c] = r2 * COLS + c2;
+                symInverse3D[s][r2 * COLS + c2] = r * COLS + c;
+            }
+        }
+    }
+}
+
+// Allocates a table of 2^sizeLog2 entries. On failure the search keeps working without one.
+bool initTT3D(int sizeLog2) {
+    freeTT3D();
+    tt3D = calloc((size_t)1 << sizeLog2, sizeof(TTSlot3D));
+    if (tt3D == NULL) return false;
+    ttMask3D = ((uint64_t)1 << sizeLog2) - 1;
+    return true;
+}
+
+// Starts a new game: entries written so far become the first to be replaced
+void newGameTT3D() {
+    ttAge3D++;
+}
+
+void freeTT3D() {
+    free(tt3D);
+    tt3D = NULL;
+    ttMask3D = 0;
+}
+
+// Canonical hash of the position and the symmetry that produces it
+static uint64_t canonicalHash3D(const Board3D *b, int *sym) {
+    uint64_t key = b->hash[0];
+    *sym = 0;
+    for (int s = 1; s < NUM_SYMMETRIES3D; s++) {
+        if (b->hash[s] < key) {
+            key = b->hash[s];
+            *sym = s;
+        }
+    }
+    return key;
+}
+
+// Packed data word: score (32 bits) | depth (8) | flag (8) | best move + 1 (8) | age (8)
+static uint64_t packTT3D(int score, int depth, int flag, int bestMove, int age) {
+    return (uint64_t)(uint32_t)score | (uint64_t)(uint8_t)depth << 32 | (uint64_t)(uint8_t)flag << 40 |
+           (uint64_t)(uint8_t)(bestMove + 1) << 48 | (uint64_t)(uint8_t)age << 56;
+}
+
+static void unpackTT3D(uint64_t data, TTEntry3D *out) {
+    out->score = (int32_t)(data & 0xFFFFFFFF);
+    out->depth = (int)((data >> 32) & 0xFF);
+    out->flag = (int)((data >> 40) & 0xFF);
+    out->bestMove = (int)((data >> 48) & 0xFF) - 1;
+    out->age = (int)(data >> 56);
+}
+
+// On a hit, out->bestMove is translated back from the canonical frame by 'sym'
+static bool probeTT3D(uint64_t key, int sym, TTEntry3D *out) {
+    if (tt3D == NULL) return false;
+    TTSlot3D *slot = &tt3D[key & ttMask3D];
+    uint64_t data = atomic_load_explicit(&slot->data, memory_order_relaxed);
+    uint64_t check = atomic_load_explicit(&slot->keyXorData, memory_order_relaxed);
+    if ((check ^ data) != key) return false;
+    unpackTT3D(data, out);
+    if (out->bestMove >= 0) out->bestMove = symInverse3D[sym][out->bestMove];
+    return out->flag != TT_EMPTY;
+}
+
+// Within a game the deeper entry is kept; entries from earlier games are always replaced
+static void storeTT3D(uint64_t key, int sym, int depth, int score, int flag, int bestMove) {
+    if (tt3D == NULL) return;
+    TTSlot3D *slot = &tt3D[key & ttMask3D];
+    TTEntry3D old;
+    unpackTT3D(atomic_load_explicit(&slot->data, memory_order_relaxed), &old);
+    if (old.flag != TT_EMPTY && old.age == ttAge3D && old.depth > depth) return;
+    uint64_t data = packTT3D(score, depth, flag, bestMove < 0 ? -1 : symColumn3D[sym][bestMove], ttAge3D);
+    atomic_store_explicit(&slot->data, data, memory_order_relaxed);
+    atomic_store_explicit(&slot->keyXorData, key ^ data, memory_order_relaxed);
+}
+
+// Win scores carry the remaining depth (faster wins score higher). Store them
+// relative to the node so an entry stays valid when reached at another depth.
+// Relative win scores can drop a little below WIN_SCORE3D, hence the wide margin.
+#define WIN_THRESHOLD3D (WIN_SCORE3D / 2)
+
+static int scoreToTT3D(int score, int depth) {
+    if (score >= WIN_THRESHOLD3D) return score - depth;
+    if (score <= -WIN_THRESHOLD3D) return score + depth;
+    return score;
+}
+
+static int scoreFromTT3D(int score, int depth) {
+    if (score >= WIN_THRESHOLD3D) return score + depth;
+    if (score <= -WIN_THRESHOLD3D) return score - depth;
+    return score;
+}
+
+// ----------------------- SEARCH -----------------------
+
+#define TIME_CHECK_INTERVAL 1024 // Nodes between clock reads
+
+// Monotonic wall clock in milliseconds
+static double nowMs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// Collects the legal columns (as r * COLS + c) for 'piece', best first: the TT move,
+// then by the evaluation after the move, with moves that complete a line on top.
+// Children of depth-1 nodes are leaves that cost as much to order as to search, so
+// apart from the TT move those keep board order.
+int orderMoves3D(Board3D *b, int piece, int depth, int ttMove, int moves[ROWS * COLS]) {
+    int keys[ROWS * COLS];
+    int count = 0;
+    for (int col = 0; col < ROWS * COLS; col++) {
+        int r = col / COLS, c = col % COLS;
+        if (!isValidMove3D(b, r, c)) continue;
+        int key = 0;
+        if (col == ttMove) {
+            key = INT_MAX - 1;
+        } else if (depth > 1) {
+            int h = makeMove3D(b, r, c, piece);
+            key = lastMoveWins3D(b, CELL3D(h, r, c), piece) ? INT_MAX
+                : (piece == AI) ? evaluateBoard3D(b) : -evaluateBoard3D(b);
+            undoMove3D(b, r, c);
+        }
+
+        // Insertion sort, highest key first
+        int pos = count++;
+        while (pos > 0 && keys[pos - 1] < key) {
+            keys[pos] = keys[pos - 1];
+            moves[pos] = moves[pos - 1];
+            pos--;
+        }
+        keys[pos] = key;
+        moves[pos] = col;
+    }
+    return count;
+}
+
+// Hooks for the shared alpha-beta core (alphaBeta.h)
+
+// Counts the node and its depth, and checks the clock and the node limit every
+// TIME_CHECK_INTERVAL nodes; true once the search must unwind
+static inline bool enterNode3D(Search3D *s) {
+    SearchShared3D *shared = s->shared;
+    int ply = s->pos.moves - s->rootMoves; // The AI's root move is ply 1
+    if (ply > s->stats.maxDepth) s->stats.maxDepth = ply;
+    if ((++s->nodes % TIME_CHECK_INTERVAL) == 0) {
+        long long total = atomic_fetch_add_explicit(&shared->nodes, TIME_CHECK_INTERVAL, memory_order_relaxed)
+                        + TIME_CHECK_INTERVAL;
+        if (nowMs() >= shared->deadlineMs || (shared->maxNodes > 0 && total >= shared->maxNodes))
+            atomic_store(&shared->stop, true);
+    }
+    return atomic_load_explicit(&shared->stop, memory_order_relaxed);
+}
+
+// Wins are detected right after each move with lastMoveWins3D, so only the side that
+// just moved is ever tested and the position passed in never has a line of four.
+static inline bool terminal3D(Search3D *s, int depth, int *score) {
+    if (isFull3D(&s->pos)) { *score = 0; return true; }
+    if (depth == 0) { *score = evaluateBoard3D(&s->pos); return true; }
+    return false;
+}
+
+static inline bool makeNode3D(Search3D *s, int col, int piece) {
+    int r = col / COLS, c = col % COLS;
+    int h = makeMove3D(&s->pos, r, c, piece);
+    return lastMoveWins3D(&s->pos, CELL3D(h, r, c), piece);
+}
+
+// Table key of a node: the canonical hash plus the symmetry that produced it
+typedef struct {
+    uint64_t hash;
+    int sym;
+} NodeKey3D;
+
+static inline NodeKey3D nodeKey3D(const Board3D *b) {
+    NodeKey3D key;
+    key.hash = canonicalHash3D(b, &key.sym);
+    return key;
+}
+
+static inline bool probeNode3D(NodeKey3D key, int depth, AlphaBetaHit *hit) {
+    TTEntry3D entry;
+    if (!probeTT3D(key.hash, key.sym, &entry)) return false;
+    *hit = (AlphaBetaHit){ scoreFromTT3D(entry.score, depth), entry.depth, entry.flag, entry.bestMove };
+    return true;
+}
+
+// minimax3D(s, depth, alpha, beta, maximizing). A winning move scores
+// WIN_SCORE3D + (depth - 1), so faster wins and slower losses are preferred.
+#define AB_NAME minimax3D
+#define AB_STATE Search3D
+#define AB_MAX_MOVES (ROWS * COLS)
+#define AB_TERMINAL(s, depth, out) terminal3D(s, depth, out)
+#define AB_GEN_MOVES(s, depth, maximizing, ttMove, moves) \
+    orderMoves3D(&(s)->pos, (maximizing) ? AI : PLAYER, depth, ttMove, moves)
+#define AB_MAKE(s, move, maximizing) makeNode3D(s, move, (maximizing) ? AI : PLAYER)
+#define AB_UNDO(s, move, maximizing) undoMove3D(&(s)->pos, (move) / COLS, (move) % COLS)
+#define AB_MOVE_WIN_SCORE(s, depth) (WIN_SCORE3D + (depth) - 1)
+#define AB_ENTER(s) enterNode3D(s)
+#define AB_ABORTED(s) atomic_load_explicit(&(s)->shared->stop, memory_order_relaxed)
+#define AB_TT_KEY_TYPE NodeKey3D
+#define AB_TT_KEY(s) nodeKey3D(&(s)->pos)
+#define AB_TT_PROBE(s, key, depth, hit) probeNode3D(key, depth, hit)
+#define AB_TT_STORE(s, key, depth, score, bound, move) \
+    storeTT3D((key).hash, (key).sym, depth, scoreToTT3D(score, depth), bound, move)
+#define AB_STATS(s) (&(s)->stats)
+#include "alphaBeta.h"
+
+// One iteration at the root: searches every AI move to 'depth' plies (the move itself
+// included), the previous iteration's best move first. Helper threads rotate the
+// remaining moves by their id so they start in different parts of the tree. Returns
+// the best column, or -1 if the search was stopped before the iteration finished.
+int searchRoot3D(Search3D *s, int depth, int pvMove, int *bestScore) {
+    Board3D *b = &s->pos;
+    int moves[ROWS * COLS];
+    int moveCount = orderMoves3D(b, AI, depth, pvMove, moves);
+    if (s->id > 0 && moveCount > 2) {
+        int rotated[ROWS * COLS];
+        int shift = s->id % (moveCount - 1);
+        for (int m = 1; m < moveCount; m++)
+            rotated[m] = moves[1 + (m - 1 + shift) % (moveCount - 1)];
+        memcpy(moves + 1, rotated + 1, (moveCount - 1) * sizeof(int));
+    }
+    int bestMove = -1;
+    int alpha = INT_MIN;
+
+    for (int m = 0; m < moveCount; m++) {
+        int r = moves[m] / COLS, c = moves[m] % COLS;
+        int h = makeMove3D(b, r, c, AI);
+        int score = lastMoveWins3D(b, CELL3D(h, r, c), AI)
+                        ? WIN_SCORE3D + (depth - 1)
+                        : minimax3D(s, depth - 1, alpha, INT_MAX, false);
+        undoMove3D(b, r, c);
+        if (atomic_load_explicit(&s->shared->stop, memory_order_relaxed)) return -1;
+        if (score > alpha) { // Later moves only replace the best with a strictly better score
+            alpha = score;
+            bestMove = moves[m];
+        }
+    }
+
+    if (bestMove != -1) {
+        int sym;
+        uint64_t key = canonicalHash3D(b, &sym);
+        storeTT3D(key, sym, depth, scoreToTT3D(alpha, depth), TT_EXACT, bestMove);
+    }
+    *bestScore = alpha;
+    return bestMove;
+}
+
+// Expected line after the AI plays firstCol: the move itself, then the table's best
+// move in each following position until the table runs out, a move wins, the board fills
+// or the line is as long as the iteration that produced it (deeper entries are stale)
+static int collectPV3D(const Board3D *root, int firstCol, int depth, int pv[SEARCH_MAX_PV]) {
+    Board3D pos = *root;
+    int length = 0;
+    int col = firstCol, piece = AI;
+    while (length < depth && length < SEARCH_MAX_PV && col >= 0 && isValidMove3D(&pos, col / COLS, col % COLS)) {
+        int h = makeMove3D(&pos, col / COLS, col % COLS, piece);
+        pv[length++] = col;
+        int sym;
+        uint64_t key = canonicalHash3D(&pos, &sym);
+        TTEntry3D entry;
+        if (lastMoveWins3D(&pos, CELL3D(h, col / COLS, col % COLS), piece) || isFull3D(&pos) ||
+            !probeTT3D(key, sym, &entry)) break;
+        col = entry.bestMove;
+        piece = (piece == AI) ? PLAYER : AI;
+    }
+    return length;
+}
+
+// Iterative deepening on one thread. Odd helpers start one ply deeper, so at any time
+// the threads are spread over two depths and fill the shared table for each other.
+static void *searchThread3D(void *arg) {
+    Search3D *s = arg;
+    SearchShared3D *shared = s->shared;
+    for (int depth = 1 + (s->id & 1); depth <= shared->maxDepth; depth++) {
+        int score;
+        int col = searchRoot3D(s, depth, s->bestCol, &score);
+        if (col == -1) break;
+        s->bestCol = col;
+        s->bestScore = score;
+        s->completedDepth = depth;
+        if (s->id == 0 && shared->onInfo != NULL) {
+            SearchInfo info = { .depth = depth, .score = score,
+                                .nodes = atomic_load(&shared->nodes) + s->nodes % TIME_CHECK_INTERVAL,
+                                .timeMs = nowMs() - shared->startMs };
+            info.pvLength = collectPV3D(&s->pos, col, depth, info.pv);
+            shared->onInfo(&info, shared->onInfoCtx);
+        }
+        // A forced win or loss inside the horizon will not change with more depth
+        if (score >= WIN_THRESHOLD3D || score <= -WIN_THRESHOLD3D) break;
+    }
+    atomic_fetch_add(&shared->nodes, s->nodes % TIME_CHECK_INTERVAL); // Not yet published by enterNode3D
+    return NULL;
+}
+
+// ----------------------- PROOF-NUMBER SOLVER -----------------------
+
+#define PN_INFINITY 0x3FFFFFFFu
+
+// One node of the proof-number tree. Children of a node are allocated together,
+// so a node only records where its block starts and how long it is.
+typedef struct {
+    uint32_t proof;      // Leaves to expand to prove the AI wins from here
+    uint32_t disproof;   // Leaves to expand to show it cannot force a win
+    int parent;          // -1 for the root
+    int firstChild;      // -1 until expanded
+    unsigned char childCount;
+    unsigned char move;  // Column (r * COLS + c) played to reach this node
+    unsigned char playerToMove; // AND node: the win must hold against every reply
+} PNNode3D;
+
+static uint32_t pnAdd3D(uint32_t a, uint32_t b) {
+    return (a + b >= PN_INFINITY) ? PN_INFINITY : a + b;
+}
+
+// Recomputes a node's numbers from its children
+static void pnSetNumbers3D(PNNode3D *pool, PNNode3D *node) {
+    uint32_t minProof = PN_INFINITY, minDisproof = PN_INFINITY, sumProof = 0, sumDisproof = 0;
+    for (int i = 0; i < node->childCount; i++) {
+        PNNode3D *child = &pool[node->firstChild + i];
+        if (child->proof < minProof) minProof = child->proof;
+        if (child->disproof < minDisproof) minDisproof = child->disproof;
+        sumProof = pnAdd3D(sumProof, child->proof);
+        sumDisproof = pnAdd3D(sumDisproof, child->disproof);
+    }
+    if (node->playerToMove) {
+        node->proof = sumProof;
+        node->disproof = minDisproof;
+    } else {
+        node->proof = minProof;
+        node->disproof = sumDisproof;
+    }
+}
+
+// Child on the most-proving path: the cheapest to prove where the AI moves,
+// the cheapest to disprove where the player moves
+static int pnSelectChild3D(const PNNode3D *pool, const PNNode3D *node) {
+    int best = node->firstChild;
+    for (int i = 1; i < node->childCount; i++) {
+        const PNNode3D *child = &pool[node->firstChild + i];
+        if (node->playerToMove ? child->disproof < pool[best].disproof
+                               : child->proof < pool[best].proof)
+            best = node->firstChild + i;
+    }
+    return best;
+}
+
+// Proof-number search for a forced AI win from 'root' with the AI to move. Uses at most
+// maxNodes tree nodes (allocated for this call only) and stops at deadlineMs. Returns
+// true and sets *winCol when a win is proven; false when disproven or out of budget.
+bool solveWin3D(const Board3D *root, double deadlineMs, int maxNodes, int *winCol) {
+    PNNode3D *pool = malloc((size_t)maxNodes * sizeof(PNNode3D));
+    if (pool == NULL) return false;
+
+    Board3D pos = *root;
+    int nodeCount = 1;
+    pool[0] = (PNNode3D){ 1, 1, -1, -1, 0, 0, 0 };
+    int current = 0; // Node whose position 'pos' holds
+    long long iterations = 0;
+
+    while (pool[0].proof != 0 && pool[0].disproof != 0) {
+        if ((++iterations % TIME_CHECK_INTERVAL) == 0 && nowMs() >= deadlineMs) break;
+
+        // Walk down the most-proving path to a leaf
+        int node = current;
+        while (pool[node].firstChild != -1) {
+            int next = pnSelectChild3D(pool, &pool[node]);
+            makeMove3D(&pos, pool[next].move / COLS, pool[next].move % COLS,
+                       pool[node].playerToMove ? PLAYER : AI);
+            node = next;
+        }
+
+        // Expand it; moves that end the game are solved on the spot
+        if (nodeCount + ROWS * COLS > maxNodes) break; // Memory cap reached
+        PNNode3D *leaf = &pool[node];
+        int mover = leaf->playerToMove ? PLAYER : AI;
+        leaf->firstChild = nodeCount;
+        for (int col = 0; col < ROWS * COLS; col++) {
+            int r = col / COLS, c = col % COLS;
+            if (!isValidMove3D(&pos, r, c)) continue;
+            int h = makeMove3D(&pos, r, c, mover);
+            PNNode3D *child = &pool[nodeCount++];
+            *child = (PNNode3D){ 1, 1, node, -1, 0, (unsigned char)col, (unsigned char)(mover == AI) };
+            if (lastMoveWins3D(&pos, CELL3D(h, r, c), mover)) {
+                child->proof = (mover == AI) ? 0 : PN_INFINITY;
+                child->disproof = (mover == AI) ? PN_INFINITY : 0;
+            } else if (isFull3D(&pos)) { // A draw is not a win
+                child->proof = PN_INFINITY;
+                child->disproof = 0;
+            }
+            undoMove3D(&pos, r, c);
+        }
+        leaf->childCount = (unsigned char)(nodeCount - leaf->firstChild);
+
+        // Back the numbers up until they stop changing. The most-proving path above that
+        // node is then unchanged, so the next walk starts from it instead of the root.
+        while (true) {
+            uint32_t oldProof = pool[node].proof, oldDisproof = pool[node].disproof;
+            pnSetNumbers3D(pool, &pool[node]);
+            if (pool[node].proof == oldProof && pool[node].disproof == oldDisproof) break;
+            if (node == 0) break;
+            undoMove3D(&pos, pool[node].move / COLS, pool[node].move % COLS);
+            node = pool[node].parent;
+        }
+        current = node;
+    }
+
+    bool proven = pool[0].proof == 0;
+    if (proven) {
+        for (int i = 0; i < pool[0].childCount; i++) {
+            if (pool[pool[0].firstChild + i].proof == 0) {
+                *winCol = pool[pool[0].firstChild + i].move;
+                break;
+            }
+        }
+    }
+    free(pool);
+    return proven;
+}
+
+// True if 'piece' has three stones on a line the opponent has not blocked
+bool hasThreat3D(const Board3D *b, int piece) {
+    int opponent = (piece == AI) ? PLAYER : AI;
+    for (int l = 0; l < NUM_LINES3D; l++) {
+        if (b->lineCount[piece][l] == 3 && b->lineCount[opponent][l] == 0) return true;
+    }
+    return false;
+}
+
+// Lazy SMP: searchThreads3D threads deepen the same root up to maxDepth plies until a
+// limit is hit, sharing only the transposition table. Returns the main thread's last
+// finished iteration, else the deepest helper result, else the first legal column
+// (-1 on a full board).
+static int searchLazySmp3D(const Board3D *root, int maxDepth, double startMs, double deadlineMs, long long maxNodes,
+                           SearchInfoCallback onInfo, void *ctx) {
+    SearchShared3D shared;
+    shared.startMs = startMs;
+    shared.deadlineMs = deadlineMs;
+    shared.maxNodes = maxNodes;
+    atomic_init(&shared.nodes, 0);
+    atomic_init(&shared.stop, false);
+    shared.maxDepth = NUM_CELLS3D - root->moves; // No point searching past a full board
+    if (shared.maxDepth > maxDepth) shared.maxDepth = maxDepth;
+    shared.onInfo = onInfo;
+    shared.onInfoCtx = ctx;
+
+    int threadCount = searchThreads3D < 1 ? 1 : searchThreads3D > MAX_SEARCH_THREADS3D ? MAX_SEARCH_THREADS3D : searchThreads3D;
+    Search3D searches[MAX_SEARCH_THREADS3D];
+    pthread_t threads[MAX_SEARCH_THREADS3D];
+    for (int i = 0; i < threadCount; i++) {
+        searches[i].pos = *root;
+        searches[i].rootMoves = root->moves;
+        searches[i].nodes = 0;
+        searches[i].stats = (SearchStats){ 0 };
+        searches[i].id = i;
+        searches[i].bestCol = -1;
+        searches[i].bestScore = 0;
+        searches[i].completedDepth = 0;
+        searches[i].shared = &shared;
+    }
+
+    int helpers = 0;
+    while (helpers + 1 < threadCount &&
+           pthread_create(&threads[helpers + 1], NULL, searchThread3D, &searches[helpers + 1]) == 0) {
+        helpers++;
+    }
+    searchThread3D(&searches[0]);
+    atomic_store(&shared.stop, true);
+    for (int i = 1; i <= helpers; i++) pthread_join(threads[i], NULL);
+    searchStats3D = (SearchStats){ 0 };
+    for (int i = 0; i <= helpers; i++) {
+        searches[i].stats.nodes = searches[i].nodes;
+        addSearchStats(&searchStats3D, &searches[i].stats);
+    }
+    searchStats3D.timeMs = nowMs() - startMs;
+
+    // Main thread out of time before its first iteration finished: use the deepest
+    // helper result, or failing that the first legal column
+    int bestCol = searches[0].bestCol;
+    if (bestCol == -1) {
+        int bestDepth = 0;
+        for (int i = 1; i <= helpers; i++) {
+            if (searches[i].completedDepth > bestDepth) {
+                bestDepth = searches[i].completedDepth;
+                bestCol = searches[i].bestCol;
+            }
+        }
+    }
+    for (int col = 0; bestCol == -1 && col < ROWS * COLS; col++) {
+        if (isValidMove3D(root, col / COLS, col % COLS)) bestCol = col;
+    }
+    return bestCol;
+}
+
+// ----------------------- MOVE SELECTION -----------------------
+
+// Plays an immediate win, else blocks the player's first immediate win. From Medium up,
+// endgames (PN_MIN_STONES or more stones) and positions where the AI has an open three
+// then go to the proof-number solver, and a proven win is played at once. Otherwise
+// runs a Lazy SMP search: searchThreads3D threads deepen the same root up to
+// `difficulty3D` until moveTimeMs3D runs out, sharing only the transposition table. The
+// main thread's last finished iteration is played; helpers are stopped as soon as it
+// is done.
+void getBestMove3D(const Board3D *root, int *bestR, int *bestC) {
+    *bestR = -1; // Initialize to invalid
+    *bestC = -1;
+    searchStats3D = (SearchStats){ 0 }; // Stays empty if a shortcut below decides the move
+    double startMs = nowMs();
+
+    Board3D pos = *root;
+    int blockCol = -1;
+    for (int col = 0; col < ROWS * COLS; col++) {
+        int r = col / COLS, c = col % COLS;
+        if (!isValidMove3D(&pos, r, c)) continue;
+
+        // Check for immediate AI win
+        int h = makeMove3D(&pos, r, c, AI);
+        bool aiWins = lastMoveWins3D(&pos, CELL3D(h, r, c), AI);
+        undoMove3D(&pos, r, c);
+        if (aiWins) {
+            *bestR = r;
+            *bestC = c;
+            searchStats3D.timeMs = nowMs() - startMs;
+            return; // Found winning move
+        }
+
+        // Check for immediate Player win to block
+        if (blockCol == -1) {
+            h = makeMove3D(&pos, r, c, PLAYER);
+            if (lastMoveWins3D(&pos, CELL3D(h, r, c), PLAYER)) blockCol = col;
+            undoMove3D(&pos, r, c);
+        }
+    }
+    if (blockCol != -1) {
+        *bestR = blockCol / COLS;
+        *bestC = blockCol % COLS;
+        searchStats3D.timeMs = nowMs() - startMs;
+        return;
+    }
+
+    int winCol;
+    if (difficulty3D > DEPTH_EASY && (root->moves >= PN_MIN_STONES || hasThreat3D(root, AI)) &&
+        solveWin3D(root, startMs + moveTimeMs3D / PN_TIME_SHARE, PN_MAX_NODES, &winCol)) {
+        *bestR = winCol / COLS;
+        *bestC = winCol % COLS;
+        searchStats3D.timeMs = nowMs() - startMs;
+        return;
+    }
+
+    int bestCol = searchLazySmp3D(root, difficulty3D, startMs, startMs + moveTimeMs3D, 0, NULL, NULL);
+    if (bestCol != -1) {
+        *bestR = bestCol / COLS;
+        *bestC = bestCol % COLS;
+    }
+}
+
+// The plain search under the text protocol's limits, ignoring difficulty3D and moveTimeMs3D
+// and without getBestMove3D's shortcuts (they would report no iterations): up to
+// limits->depth plies, the AI's move included, all empty cells if 0
+void getBestMove3DLimited(const Board3D *root, const SearchLimits *limits, SearchInfoCallback onInfo, void *ctx,
+                          int *bestR, int *bestC) {
+    double startMs = nowMs();
+    int maxDepth = limits->depth > 0 ? limits->depth : NUM_CELLS3D;
+    double deadlineMs = limits->timeMs > 0 ? startMs + limits->timeMs : DBL_MAX;
+    int bestCol = searchLazySmp3D(root, maxDepth, startMs, deadlineMs, limits->nodes, onInfo, ctx);
+    *bestR = bestCol == -1 ? -1 : bestCol / COLS;
+    *bestC = bestCol == -1 ? -1 : bestCol % COLS;
+}
+
+bool isFull3D(const Board3D *b) {
+    return b->moves == NUM_CELLS3D;
+}
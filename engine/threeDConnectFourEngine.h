@@ -0,0 +1,94 @@
+// threeDConnectFourEngine.h - Board, rules and AI for Sogo (4x4x4 Connect Four)
+//
+// Headless: nothing here depends on raylib. Positions are Board3D values owned by
+// the caller; the search settings, the line tables and the transposition table are
+// globals, one game per process.
+
+#ifndef THREED_CONNECT_FOUR_ENGINE_H
+#define THREED_CONNECT_FOUR_ENGINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "searchInfo.h"
+
+// Define constants
+#define ROWS 4 // Changed for Sogo-like 4x4x4
+#define COLS 4 // Changed for Sogo-like 4x4x4
+#define PLAYER 1
+#define AI 2
+#define EMPTY 0
+#define HEIGHT 4 // Already 4, but confirming for 4x4x4
+#define NUM_CELLS3D (HEIGHT * ROWS * COLS)
+#define NUM_LINES3D 76 // Winning lines of four on the 4x4x4 board
+#define MAX_CELL_LINES3D 7 // Most lines through one cell (corners and the 8 inner cells)
+#define WIN_SCORE3D 100000 // Above any line-potential evaluation
+
+// Bitboard layout: bit (h * 16 + r * 4 + c) is cell (h, r, c), h = 0 at the bottom
+#define CELL3D(h, r, c) (((h) * ROWS + (r)) * COLS + (c))
+#define BIT3D(cell) (1ULL << (cell))
+
+// Symmetries of the 4x4 footprint (rotations and reflections). Gravity is unaffected,
+// so each maps a position to an equivalent one with the same value.
+#define NUM_SYMMETRIES3D 8
+
+typedef struct {
+    uint64_t stones[3];          // Stone mask per piece, indexed by PLAYER / AI (EMPTY unused)
+    int height[ROWS * COLS];     // Stones in each (r, c) column, i.e. the next landing height
+    int moves;                   // Stones on the board
+    unsigned char lineCount[3][NUM_LINES3D]; // Stones of each piece on each line
+    int eval;                    // Line potential of AI minus PLAYER, kept by make/undo
+    uint64_t hash[NUM_SYMMETRIES3D]; // Zobrist hash of the position and side to move under each symmetry
+} Board3D; // Plain value type: copying it gives an independent position
+
+typedef struct {
+    uint64_t mask;               // The four cells as a bitboard
+    unsigned char cells[4];      // The same cells in order along the line
+} Line3D;
+
+// Search settings, read at the start of every AI move
+extern int difficulty3D;    // Depth cap, in plies counting the AI's own move
+extern int moveTimeMs3D;    // Wall-clock budget per AI move; the last fully searched depth is played
+#define MAX_SEARCH_THREADS3D 64
+extern int searchThreads3D; // Main search thread plus helpers
+extern SearchStats searchStats3D; // Work of the last search; the shortcuts and the PN solver count no nodes
+
+extern Line3D lines3D[NUM_LINES3D]; // Filled once by initLines3D
+
+// Default table size as a power of two (2^20 entries * 16 bytes = 16 MB)
+#define TT_DEFAULT_SIZE_LOG2 20
+
+// Difficulty Levels: a depth cap and a time budget per AI move. Iterative deepening
+// stops at whichever comes first, so each level takes a predictable time per move.
+#define DEPTH_EASY 3 // Plies, counting the AI's own move
+#define DEPTH_MEDIUM 6
+#define DEPTH_HARD NUM_CELLS3D // As deep as the time budget allows
+#define TIME_EASY_MS 250
+#define TIME_MEDIUM_MS 500
+#define TIME_HARD_MS 1500
+
+void initLines3D(); // Call once before any other function
+void resetBoard3D(Board3D *b);
+bool isValidMove3D(const Board3D *b, int r, int c);
+int makeMove3D(Board3D *b, int r, int c, int piece); // Landing height, or -1
+void undoMove3D(Board3D *b, int r, int c);
+bool winningMove3D(const Board3D *b, int piece);
+int findWinningLine3D(const Board3D *b, int piece); // Index into lines3D, or -1
+bool lastMoveWins3D(const Board3D *b, int cell, int piece);
+int cellAt3D(const Board3D *b, int h, int r, int c);
+bool isFull3D(const Board3D *b);
+int evaluateBoard3D(const Board3D *b);
+
+// Call initZobrist3D once; without initTT3D the search runs without a table
+void initZobrist3D();
+bool initTT3D(int sizeLog2);
+void newGameTT3D(); // Ages the table at the start of each game
+void freeTT3D();
+
+// Best (r, c) column for AI in root, or -1, -1
+void getBestMove3D(const Board3D *root, int *bestR, int *bestC);
+void getBestMove3DLimited(const Board3D *root, const SearchLimits *limits, SearchInfoCallback onInfo, void *ctx,
+                          int *bestR, int *bestC);
+bool solveWin3D(const Board3D *root, double deadlineMs, int maxNodes, int *winCol);
+bool hasThreat3D(const Board3D *b, int piece);
+
+#endif // THREED_CONNECT_FOUR_ENGINE_H
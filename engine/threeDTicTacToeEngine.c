@@ -0,0 +1,434 @@
+// threeDTicTacToeEngine.c - Board, rules and AI for 3D Tic-Tac-Toe (no raylib)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h> // For INT_MIN, INT_MAX
+#include <string.h> // For memcpy
+#include <time.h> // For clock_gettime
+#include <stdatomic.h> // For the search cancel flag
+#include <pthread.h> // For the background AI worker
+#include "threeDTicTacToeEngine.h"
+#include "alphaBeta.h"       // Shared search core
+
+// Global variables for player symbols
+char USER_SYMBOL = 'X'; // Default, can be changed
+char AI_SYMBOL = 'O';
+
+// The 49 winning lines, as flat cell indices layer * 9 + row * 3 + col
+const unsigned char WIN_LINES[NUM_LINES][3] = {
+    // Layer 0: rows, columns, diagonals
+    { 0,  1,  2}, { 3,  4,  5}, { 6,  7,  8}, { 0,  3,  6},
+    { 1,  4,  7}, { 2,  5,  8}, { 0,  4,  8}, { 2,  4,  6},
+    // Layer 1: rows, columns, diagonals
+    { 9, 10, 11}, {12, 13, 14}, {15, 16, 17}, { 9, 12, 15},
+    {10, 13, 16}, {11, 14, 17}, { 9, 13, 17}, {11, 13, 15},
+    // Layer 2: rows, columns, diagonals
+    {18, 19, 20}, {21, 22, 23}, {24, 25, 26}, {18, 21, 24},
+    {19, 22, 25}, {20, 23, 26}, {18, 22, 26}, {20, 22, 24},
+    // Diagonals across layers with a fixed row
+    { 0, 10, 20}, { 2, 10, 18}, { 3, 13, 23}, { 5, 13, 21},
+    { 6, 16, 26}, { 8, 16, 24},
+    // Diagonals across layers with a fixed column
+    { 0, 12, 24}, { 6, 12, 18}, { 1, 13, 25}, { 7, 13, 19},
+    { 2, 14, 26}, { 8, 14, 20},
+    // Straight through the layers
+    { 0,  9, 18}, { 1, 10, 19}, { 2, 11, 20}, { 3, 12, 21},
+    { 4, 13, 22}, { 5, 14, 23}, { 6, 15, 24}, { 7, 16, 25},
+    { 8, 17, 26},
+    // Space diagonals
+    { 0, 13, 26}, { 2, 13, 24}, { 6, 13, 20}, { 8, 13, 18}
+};
+
+// The AI searches on 27-bit stone masks, bit (layer * 9 + row * 3 + col) per cell.
+// LINE_MASKS[i] has the three bits of WIN_LINES[i].
+#define CELL_BIT(cell) (1u << (cell))
+#define FULL_BOARD_MASK ((1u << (SIZE * SIZE * SIZE)) - 1)
+static const uint32_t LINE_MASKS[NUM_LINES] = {
+    0x0000007, 0x0000038, 0x00001C0, 0x0000049, 0x0000092, 0x0000124, 0x0000111, 0x0000054,
+    0x0000E00, 0x0007000, 0x0038000, 0x0009200, 0x0012400, 0x0024800, 0x0022200, 0x000A800,
+    0x01C0000, 0x0E00000, 0x7000000, 0x1240000, 0x2480000, 0x4900000, 0x4440000, 0x1500000,
+    0x0100401, 0x0040404, 0x0802008, 0x0202020, 0x4010040, 0x1010100,
+    0x1001001, 0x0041040, 0x2002002, 0x0082080, 0x4004004, 0x0104100,
+    0x0040201, 0x0080402, 0x0100804, 0x0201008, 0x0402010, 0x0804020, 0x1008040, 0x2010080,
+    0x4020100,
+    0x4002001, 0x1002004, 0x0102040, 0x0042100
+};
+
+// Set to make a running GetAIMove give up; it then returns no move
+atomic_bool aiSearchCancelled = false;
+
+// Background AI search, so the 3D view keeps rendering while the AI thinks
+typedef struct {
+    pthread_t thread;
+    char board[SIZE][SIZE][SIZE]; // Snapshot of the board the worker searches
+    int ply;
+    atomic_bool done;             // Set by the worker once bestL/bestR/bestC are valid
+    int bestL, bestR, bestC;
+    SearchStats stats;
+    bool running;
+} AIWorker;
+
+static AIWorker aiWorker;
+
+// Position searched by Minimax: both players' stones and the plies played since the AI's root move,
+// plus the limits of GetAIMoveLimited (0 for none) and the principal variation of each ply
+typedef struct {
+    uint32_t ai, user;
+    int ply;
+    long long nodes;
+    long long maxNodes;
+    double deadlineMs;
+    bool aborted;                                          // A limit was hit; every node unwinds
+    SearchStats stats;
+    int pv[SIZE * SIZE * SIZE + 1][SIZE * SIZE * SIZE];    // pv[ply]: best line found from that ply on
+    int pvLength[SIZE * SIZE * SIZE + 1];
+} SearchState;
+
+#define TIME_CHECK_INTERVAL 1024 // Nodes between clock reads
+
+int Minimax(SearchState *s, int depth, int alpha, int beta, bool isMaximizing);
+
+// --- Board Functions ---
+
+void InitializeBoard3D(char board[SIZE][SIZE][SIZE]) {
+    for (int i = 0; i < SIZE; i++) {
+        for (int j = 0; j < SIZE; j++) {
+            for (int k = 0; k < SIZE; k++) {
+                board[i][j][k] = EMPTY;
+            }
+        }
+    }
+}
+
+bool IsValidMove(char board[SIZE][SIZE][SIZE], int layer, int row, int col) {
+    return layer >= 0 && layer < SIZE &&
+           row >= 0 && row < SIZE &&
+           col >= 0 && col < SIZE &&
+           board[layer][row][col] == EMPTY;
+}
+
+bool IsBoardFull(char board[SIZE][SIZE][SIZE]) {
+    for (int i = 0; i < SIZE; i++) {
+        for (int j = 0; j < SIZE; j++) {
+            for (int k = 0; k < SIZE; k++) {
+                if (board[i][j][k] == EMPTY) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Index into WIN_LINES of a completed line, or -1. Pure: safe to call from the search.
+int FindWinningLine(char board[SIZE][SIZE][SIZE]) {
+    const char *cells = &board[0][0][0];
+    for (int i = 0; i < NUM_LINES; i++) {
+        char first = cells[WIN_LINES[i][0]];
+        if (first != EMPTY && first == cells[WIN_LINES[i][1]] && first == cells[WIN_LINES[i][2]]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Symbol that completed a line, or EMPTY. Has no side effects; the search calls it at every node.
+char CheckWinner3D(char board[SIZE][SIZE][SIZE]) {
+    int line = FindWinningLine(board);
+    return (line == -1) ? EMPTY : (&board[0][0][0])[WIN_LINES[line][0]];
+}
+
+
+// --- AI Logic ---
+
+// Stone mask of one symbol on the display board
+uint32_t SymbolMask(char board[SIZE][SIZE][SIZE], char symbol) {
+    const char *cells = &board[0][0][0];
+    uint32_t mask = 0;
+    for (int i = 0; i < SIZE * SIZE * SIZE; i++) {
+        if (cells[i] == symbol) mask |= CELL_BIT(i);
+    }
+    return mask;
+}
+
+// True if the stones complete any winning line
+bool HasLine(uint32_t stones) {
+    uint32_t found = 0;
+    for (int i = 0; i < NUM_LINES; i++) {
+        found |= ((stones & LINE_MASKS[i]) == LINE_MASKS[i]);
+    }
+    return found != 0;
+}
+
+// Line potential of 'mine': every line the opponent has not blocked scores 1 for one stone on it
+// and 10 for two. The stone count of a 3-cell line is read from its bits (none, a single bit, all
+// three) rather than with a popcount, which keeps the loop branch-free so the compiler can
+// vectorize it across lines.
+int CalculateTotalHeuristic(uint32_t mine, uint32_t theirs) {
+    uint32_t totalScore = 0;
+    for (int i = 0; i < NUM_LINES; i++) {
+        uint32_t m = mine & LINE_MASKS[i];
+        uint32_t open = (theirs & LINE_MASKS[i]) == 0;
+        uint32_t single = (m & (m - 1)) == 0;
+        uint32_t full = m == LINE_MASKS[i];
+        totalScore += open & (m != 0) & (single + 10u * (!single & !full));
+    }
+    return (int)totalScore;
+}
+
+// Evaluate the position for the Minimax algorithm
+int EvaluateBoard(uint32_t ai, uint32_t user) {
+    if (HasLine(ai)) {
+        return WIN_SCORE; // AI wins immediately
+    } else if (HasLine(user)) {
+        return LOSS_SCORE; // User wins immediately
+    } else {
+        // No immediate winner: difference in line potential
+        return CalculateTotalHeuristic(ai, user) - CalculateTotalHeuristic(user, ai);
+    }
+}
+
+// Move ordering class: the center lies on 13 winning lines, corners on 7, the rest on 4 or 5
+static int MoveClass(int layer, int row, int col) {
+    int outer = (layer != 1) + (row != 1) + (col != 1); // Coordinates on an outer face
+    if (outer == 0) return 2; // Center
+    if (outer == 3) return 1; // Corner
+    return 0;
+}
+
+// Collects the empty cells (encoded as layer * 9 + row * 3 + col) in search order: center first,
+// then corners, then by the line potential CalculateTotalHeuristic gives the position after the
+// move (mover's potential minus the opponent's, so blocking moves rank high too).
+int OrderMoves(uint32_t mover, uint32_t opponent, int moves[SIZE * SIZE * SIZE]) {
+    uint32_t empty = ~(mover | opponent) & FULL_BOARD_MASK;
+    int keys[SIZE * SIZE * SIZE];
+    int count = 0;
+
+    for (int cell = 0; cell < SIZE * SIZE * SIZE; cell++) {
+        if (!(empty & CELL_BIT(cell))) continue;
+        uint32_t after = mover | CELL_BIT(cell);
+        // Heuristic totals stay within +-490, so the class always dominates
+        int key = MoveClass(cell / 9, (cell / 3) % 3, cell % 3) * 1000 +
+                  CalculateTotalHeuristic(after, opponent) - CalculateTotalHeuristic(opponent, after);
+
+        // Insertion sort, highest key first
+        int pos = count++;
+        while (pos > 0 && keys[pos - 1] < key) {
+            keys[pos] = keys[pos - 1];
+            moves[pos] = moves[pos - 1];
+            pos--;
+        }
+        keys[pos] = key;
+        moves[pos] = cell;
+    }
+    return count;
+}
+
+// Monotonic wall clock in milliseconds
+static double NowMs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// Hooks for the shared alpha-beta core (alphaBeta.h)
+
+// Counts the node and its depth, starts its line empty and checks the limits (the clock
+// only every TIME_CHECK_INTERVAL nodes); true once the search must unwind. A cancelled
+// search's result is discarded.
+static inline bool EnterNode(SearchState *s) {
+    s->pvLength[s->ply] = 0;
+    s->nodes++;
+    if (s->ply + 1 > s->stats.maxDepth) s->stats.maxDepth = s->ply + 1; // The AI's root move is ply 1
+    if (s->maxNodes > 0 && s->nodes >= s->maxNodes) s->aborted = true;
+    if (s->deadlineMs > 0 && s->nodes % TIME_CHECK_INTERVAL == 0 && NowMs() >= s->deadlineMs) s->aborted = true;
+    return s->aborted || atomic_load_explicit(&aiSearchCancelled, memory_order_relaxed);
+}
+
+static inline bool Terminal(const SearchState *s, int depth, int *score) {
+    // Check for immediate win/loss/draw first
+    if (HasLine(s->ai)) { *score = WIN_SCORE - s->ply; return true; } // Prioritize faster wins
+    if (HasLine(s->user)) { *score = LOSS_SCORE + s->ply; return true; } // Prioritize blocking faster losses
+    if ((s->ai | s->user) == FULL_BOARD_MASK) { *score = DRAW_SCORE; return true; } // Draw
+    if (depth == 0) { *score = EvaluateBoard(s->ai, s->user); return true; } // Evaluate heuristic at max depth
+    return false;
+}
+
+static inline void PlaceStone(SearchState *s, int cell, bool isMaximizing) {
+    if (isMaximizing) s->ai |= CELL_BIT(cell); else s->user |= CELL_BIT(cell);
+    s->ply++;
+}
+
+static inline void RemoveStone(SearchState *s, int cell, bool isMaximizing) {
+    if (isMaximizing) s->ai &= ~CELL_BIT(cell); else s->user &= ~CELL_BIT(cell);
+    s->ply--;
+}
+
+// The line from this ply is the move followed by the child's line
+static inline void UpdatePV(SearchState *s, int cell) {
+    int childLength = s->pvLength[s->ply + 1];
+    s->pv[s->ply][0] = cell;
+    memcpy(&s->pv[s->ply][1], s->pv[s->ply + 1], childLength * sizeof(int));
+    s->pvLength[s->ply] = 1 + childLength;
+}
+
+// Minimax(s, depth, alpha, beta, isMaximizing): alpha-beta pruning, fail-soft (the returned
+// score may lie outside [alpha, beta]). depth is the number of plies left to the horizon.
+#define AB_NAME Minimax
+#define AB_STATE SearchState
+#define AB_MAX_MOVES (SIZE * SIZE * SIZE)
+#define AB_TERMINAL(s, depth, out) Terminal(s, depth, out)
+#define AB_GEN_MOVES(s, depth, isMaximizing, ttMove, moves) \
+    ((isMaximizing) ? OrderMoves((s)->ai, (s)->user, moves) : OrderMoves((s)->user, (s)->ai, moves))
+#define AB_MAKE(s, cell, isMaximizing) (PlaceStone(s, cell, isMaximizing), false)
+#define AB_UNDO(s, cell, isMaximizing) RemoveStone(s, cell, isMaximizing)
+#define AB_ENTER(s) EnterNode(s)
+#define AB_ABORTED(s) ((s)->aborted)
+#define AB_PV_UPDATE(s, cell, searched) UpdatePV(s, cell) // AB_MAKE never reports a win here
+#define AB_STATS(s) (&(s)->stats)
+#include "alphaBeta.h"
+
+void GetAIMove(char board[SIZE][SIZE][SIZE], int ply, SearchStats *stats, int *bestL, int *bestR, int *bestC) {
+    double startMs = NowMs();
+    SearchStats total = { 0 };
+    int bestScore = INT_MIN;
+    *bestL = -1; *bestR = -1; *bestC = -1;
+    typedef struct { int l, r, c; } Move;
+    Move bestMoves[SIZE*SIZE*SIZE];
+    int numBestMoves = 0;
+
+    uint32_t ai = SymbolMask(board, AI_SYMBOL);
+    uint32_t user = SymbolMask(board, USER_SYMBOL);
+    int moves[SIZE * SIZE * SIZE];
+    int scores[SIZE * SIZE * SIZE];
+    int count = OrderMoves(ai, user, moves);
+    for (int i = 0; i < SIZE * SIZE * SIZE; i++) scores[i] = INT_MIN;
+
+    for (int m = 0; m < count && !atomic_load(&aiSearchCancelled); m++) {
+        // Alpha sits one below the best score so far: moves that tie it still get an exact
+        // score (for the random tie-break below), anything worse fails low and is cut short.
+        int alpha = (bestScore == INT_MIN) ? INT_MIN : bestScore - 1;
+        SearchState state = { .ai = ai | CELL_BIT(moves[m]), .user = user };
+        int moveScore = Minimax(&state, ply, alpha, INT_MAX, false);
+        state.stats.nodes = state.nodes;
+        addSearchStats(&total, &state.stats);
+
+        scores[moves[m]] = moveScore;
+        if (moveScore > bestScore) bestScore = moveScore;
+    }
+
+    total.timeMs = NowMs() - startMs;
+    if (stats != NULL) *stats = total;
+    if (atomic_load(&aiSearchCancelled)) return; // Leaves the move at -1
+
+    // Collect the equally best moves in board order; fail-low scores are always below bestScore
+    for (int i = 0; i < SIZE * SIZE * SIZE; i++) {
+        if (scores[i] != INT_MIN && scores[i] == bestScore) {
+            bestMoves[numBestMoves++] = (Move){i / 9, (i / 3) % 3, i % 3};
+        }
+    }
+
+    if (numBestMoves > 0) {
+        int randomIndex = rand() % numBestMoves;
+        *bestL = bestMoves[randomIndex].l;
+        *bestR = bestMoves[randomIndex].r;
+        *bestC = bestMoves[randomIndex].c;
+    }
+}
+
+// Iterative deepening for the text protocol: searches 1, 2, ... plies (the AI's move
+// included) until limits->depth or the board is exhausted, or a node or time limit
+// stops it, and reports each finished iteration to onInfo (which may be NULL). The
+// previous iteration's best move is searched first; ties keep the earlier move.
+// Returns false if no iteration finished; the move is then the first move in search
+// order, or -1 if the board is full.
+bool GetAIMoveLimited(char board[SIZE][SIZE][SIZE], const SearchLimits *limits, SearchInfoCallback onInfo, void *ctx,
+                      int *bestL, int *bestR, int *bestC) {
+    double startMs = NowMs();
+    uint32_t ai = SymbolMask(board, AI_SYMBOL);
+    uint32_t user = SymbolMask(board, USER_SYMBOL);
+    int moves[SIZE * SIZE * SIZE];
+    int count = OrderMoves(ai, user, moves);
+    *bestL = *bestR = *bestC = -1;
+    if (count == 0) return false;
+    *bestL = moves[0] / 9; *bestR = (moves[0] / 3) % 3; *bestC = moves[0] % 3;
+    int maxDepth = (limits->depth > 0 && limits->depth < count) ? limits->depth : count;
+
+    SearchState s = { .ai = ai, .user = user, .maxNodes = limits->nodes,
+                      .deadlineMs = limits->timeMs > 0 ? startMs + limits->timeMs : 0 };
+
+    bool found = false;
+    for (int depth = 1; depth <= maxDepth; depth++) {
+        int bestScore = INT_MIN, bestIndex = -1;
+        SearchInfo info = { .depth = depth };
+        for (int m = 0; m < count; m++) {
+            s.ai = ai | CELL_BIT(moves[m]);
+            int moveScore = Minimax(&s, depth - 1, bestScore, INT_MAX, false);
+            s.ai = ai;
+            if (s.aborted || atomic_load(&aiSearchCancelled)) break;
+            if (moveScore > bestScore) {
+                bestScore = moveScore;
+                bestIndex = m;
+                info.pv[0] = moves[m];
+                memcpy(&info.pv[1], s.pv[0], s.pvLength[0] * sizeof(int));
+                info.pvLength = 1 + s.pvLength[0];
+            }
+        }
+        if (s.aborted || atomic_load(&aiSearchCancelled) || bestIndex == -1) break;
+
+        int best = moves[bestIndex];
+        *bestL = best / 9; *bestR = (best / 3) % 3; *bestC = best % 3;
+        found = true;
+        info.score = bestScore;
+        info.nodes = s.nodes;
+        info.timeMs = NowMs() - startMs;
+        if (onInfo != NULL) onInfo(&info, ctx);
+
+        memmove(&moves[1], &moves[0], bestIndex * sizeof(int)); // Best move first next time
+        moves[0] = best;
+    }
+    return found;
+}
+
+// --- AI Worker ---
+
+static void *AIWorkerMain(void *arg) {
+    AIWorker *w = arg;
+    GetAIMove(w->board, w->ply, &w->stats, &w->bestL, &w->bestR, &w->bestC);
+    atomic_store(&w->done, true);
+    return NULL;
+}
+
+// Starts searching a copy of board in the background. Returns false if the thread could not be created.
+bool StartAIWorker(char board[SIZE][SIZE][SIZE], int ply) {
+    memcpy(aiWorker.board, board, sizeof(aiWorker.board));
+    aiWorker.ply = ply;
+    aiWorker.bestL = aiWorker.bestR = aiWorker.bestC = -1;
+    atomic_store(&aiWorker.done, false);
+    atomic_store(&aiSearchCancelled, false);
+    aiWorker.running = pthread_create(&aiWorker.thread, NULL, AIWorkerMain, &aiWorker) == 0;
+    return aiWorker.running;
+}
+
+// Non-blocking: returns true (and joins the thread) once the worker has a move and its stats
+bool PollAIWorker(int *bestL, int *bestR, int *bestC, SearchStats *stats) {
+    if (!aiWorker.running || !atomic_load(&aiWorker.done)) return false;
+    pthread_join(aiWorker.thread, NULL);
+    aiWorker.running = false;
+    *bestL = aiWorker.bestL; *bestR = aiWorker.bestR; *bestC = aiWorker.bestC;
+    if (stats != NULL) *stats = aiWorker.stats;
+    return true;
+}
+
+// True between a successful StartAIWorker and the PollAIWorker/StopAIWorker that joins it
+bool IsAIWorkerRunning(void) {
+    return aiWorker.running;
+}
+
+// Asks a running search to stop and waits for it, discarding its move
+void StopAIWorker(void) {
+    if (!aiWorker.running) return;
+    atomic_store(&aiSearchCancelled, true);
+    pthread_join(aiWorker.thread, NULL);
+    aiWorker.running = false;
+}
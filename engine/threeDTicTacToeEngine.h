@@ -0,0 +1,51 @@
+// threeDTicTacToeEngine.h - Board, rules and AI for 3D Tic-Tac-Toe
+//
+// Headless: nothing here depends on raylib. The board is passed in by the caller;
+// the player symbols and the background worker are globals, one game per process.
+// Cells are addressed as [layer][row][col], or flat as layer * 9 + row * 3 + col.
+
+#ifndef THREED_TIC_TAC_TOE_ENGINE_H
+#define THREED_TIC_TAC_TOE_ENGINE_H
+
+#include <stdbool.h>
+#include <stdint.h> // For uint32_t
+#include "searchInfo.h"
+
+#define SIZE 3
+#define EMPTY ' '
+#define WIN_SCORE 100
+#define LOSS_SCORE -100
+#define DRAW_SCORE 0
+
+#define NUM_LINES 49
+extern const unsigned char WIN_LINES[NUM_LINES][3]; // Flat cell indices of each winning line
+
+extern char USER_SYMBOL; // 'X' or 'O'
+extern char AI_SYMBOL;
+
+void InitializeBoard3D(char board[SIZE][SIZE][SIZE]);
+bool IsValidMove(char board[SIZE][SIZE][SIZE], int layer, int row, int col);
+bool IsBoardFull(char board[SIZE][SIZE][SIZE]);
+char CheckWinner3D(char board[SIZE][SIZE][SIZE]);   // Symbol that completed a line, or EMPTY
+int FindWinningLine(char board[SIZE][SIZE][SIZE]);  // Index into WIN_LINES, or -1
+
+// Search on 27-bit stone masks
+uint32_t SymbolMask(char board[SIZE][SIZE][SIZE], char symbol);
+bool HasLine(uint32_t stones);
+int CalculateTotalHeuristic(uint32_t mine, uint32_t theirs);
+int EvaluateBoard(uint32_t ai, uint32_t user);
+int OrderMoves(uint32_t mover, uint32_t opponent, int moves[SIZE * SIZE * SIZE]);
+
+// Best move for AI_SYMBOL searching `ply` plies; -1 in *bestL if there is none or the search was stopped.
+// The search's work goes to *stats unless stats is NULL.
+void GetAIMove(char board[SIZE][SIZE][SIZE], int ply, SearchStats *stats, int *bestL, int *bestR, int *bestC);
+bool GetAIMoveLimited(char board[SIZE][SIZE][SIZE], const SearchLimits *limits, SearchInfoCallback onInfo, void *ctx,
+                      int *bestL, int *bestR, int *bestC);
+
+// Background search: Start, then Poll once per frame until it returns true; Stop cancels
+bool StartAIWorker(char board[SIZE][SIZE][SIZE], int ply);
+bool PollAIWorker(int *bestL, int *bestR, int *bestC, SearchStats *stats);
+bool IsAIWorkerRunning(void);
+void StopAIWorker(void);
+
+#endif // THREED_TIC_TAC_TOE_ENGINE_H
@@ -0,0 +1,552 @@
+// twoDConnectFourEngine.c - Board, rules and AI for 2D Connect Four (no raylib)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <time.h>
+#include <float.h> // For DBL_MAX
+#include "twoDConnectFourEngine.h"
+#include "alphaBeta.h" // Shared search core
+
+int difficulty2D = 4; // Default difficulty: maximum search depth
+int moveTimeMs2D = 1000; // Wall-clock budget per AI move; the last fully searched depth is played
+int searchThreads = 1; // Root moves searched in parallel; set from the CPU count at startup
+
+// Zobrist keys, one per (piece, bit index). The empty board hashes to 0.
+uint64_t zobrist2D[3][COLS * BB_COL_HEIGHT];
+// Part of the hash while PLAYER is to move. Positions with as many AI as PLAYER
+// stones occur with either side to move, depending on who went first.
+uint64_t zobristSide2D;
+
+// Transposition table bound types
+#define TT_EMPTY 0 // Slot has never been written
+#define TT_EXACT AB_BOUND_EXACT
+#define TT_LOWER AB_BOUND_LOWER
+#define TT_UPPER AB_BOUND_UPPER
+
+typedef struct {
+    int score;    // Win scores are stored relative to this node (see scoreToTT2D)
+    int depth;    // Remaining depth the score was searched to
+    int flag;     // TT_EXACT / TT_LOWER / TT_UPPER
+    int bestMove; // Best column found, -1 if none
+} TTEntry2D;
+
+// Table slots are shared by all search threads without locks. The entry is
+// packed into one word and the key is stored XORed with it, so a slot torn by
+// two concurrent writers fails the key check instead of returning mixed data.
+typedef struct {
+    _Atomic uint64_t keyXorData;
+    _Atomic uint64_t data;
+} TTSlot2D;
+
+TTSlot2D *tt2D = NULL; // Search runs without a table if this is NULL
+uint64_t ttMask2D = 0;
+
+// Shared by all threads working on one AI move
+typedef struct {
+    double deadlineMs;
+    long long maxNodes;     // 0 for no node limit
+    atomic_bool aborted;    // Set once a limit is hit or a stop is requested; every thread unwinds
+    atomic_int rootAlpha;   // Best root score proven so far, raised as root moves finish
+    SearchProgress2D *progress;
+    pthread_mutex_t lock;   // Guards bestCol / bestScore / stats
+    int bestCol;
+    int bestScore;
+    SearchStats stats;      // Every worker's counters, added as it finishes
+} SearchShared2D;
+
+// Per-thread search state: a private copy of the position plus counters
+typedef struct {
+    Board2D pos;
+    int rootMoves;          // Pieces on the board at the root, to tell the ply of a node
+    long long nodes;
+    SearchStats stats;
+    SearchShared2D *shared;
+} Search2D;
+
+AIWorker2D aiWorker2D;
+
+int searchRoot2D(const Board2D *root, int depth, int pvMove, int *bestScore, SearchShared2D *shared);
+int minimax2D(Search2D *s, int depth, int alpha, int beta, bool maximizing);
+
+// ----------------------- 2D CONNECT 4 FUNCTIONS -----------------------
+
+bool isValidMove2D(const Board2D *b, int col) {
+    return col >= 0 && col < COLS && b->height[col] < ROWS;
+}
+
+// Returns the display row (0 = top) the piece landed in, or -1 if the column is full
+int makeMove2D(Board2D *b, int col, int piece) {
+    int h = b->height[col];
+    if (h >= ROWS) return -1;
+    b->stones[piece] |= BB_BIT(col, h);
+    b->hash ^= zobrist2D[piece][col * BB_COL_HEIGHT + h];
+    // The empty board counts as AI to move, so only PLAYER's first stone keeps the side key off
+    if (piece == AI || b->moves > 0) b->hash ^= zobristSide2D;
+    b->height[col]++;
+    b->moves++;
+    return ROWS - 1 - h;
+}
+
+void undoMove2D(Board2D *b, int col) {
+    if (b->height[col] == 0) return;
+    int h = --b->height[col];
+    uint64_t bit = BB_BIT(col, h);
+    int piece = (b->stones[AI] & bit) ? AI : PLAYER;
+    b->hash ^= zobrist2D[piece][col * BB_COL_HEIGHT + h];
+    b->stones[PLAYER] &= ~bit;
+    b->stones[AI] &= ~bit;
+    b->moves--;
+    if (piece == AI || b->moves > 0) b->hash ^= zobristSide2D;
+}
+
+// Four shift-and-AND tests, one per direction. Shifting by d pairs every stone
+// with its neighbour d bits away; doing it twice finds four in a row.
+bool winningMove2D(const Board2D *b, int piece) {
+    uint64_t s = b->stones[piece];
+    uint64_t m;
+    // Vertical
+    m = s & (s >> 1);
+    if (m & (m >> 2)) return true;
+    // Horizontal
+    m = s & (s >> BB_COL_HEIGHT);
+    if (m & (m >> (2 * BB_COL_HEIGHT))) return true;
+    // Negative Diagonal
+    m = s & (s >> (BB_COL_HEIGHT - 1));
+    if (m & (m >> (2 * (BB_COL_HEIGHT - 1)))) return true;
+    // Positive Diagonal
+    m = s & (s >> (BB_COL_HEIGHT + 1));
+    if (m & (m >> (2 * (BB_COL_HEIGHT + 1)))) return true;
+    return false;
+}
+
+// Piece at display coordinates (r = 0 is the top row), used by the renderer
+int cellAt2D(const Board2D *b, int r, int c) {
+    uint64_t bit = BB_BIT(c, ROWS - 1 - r);
+    if (b->stones[PLAYER] & bit) return PLAYER;
+    if (b->stones[AI] & bit) return AI;
+    return EMPTY;
+}
+
+bool isFull2D(const Board2D *b) {
+    return b->moves == ROWS * COLS;
+}
+
+// ----------------------- TRANSPOSITION TABLE -----------------------
+
+// splitmix64, only used to fill the Zobrist keys deterministically
+static uint64_t nextRandom64(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void initZobrist2D() {
+    uint64_t seed = 0x2D4C4F5552ULL;
+    for (int p = 0; p < 3; p++)
+        for (int i = 0; i < COLS * BB_COL_HEIGHT; i++)
+            zobrist2D[p][i] = nextRandom64(&seed);
+    zobristSide2D = nextRandom64(&seed);
+}
+
+// Allocates a table of 2^sizeLog2 entries. On failure the search keeps working without one.
+bool initTT2D(int sizeLog2) {
+    freeTT2D();
+    tt2D = calloc((size_t)1 << sizeLog2, sizeof(TTSlot2D));
+    if (tt2D == NULL) return false;
+    ttMask2D = ((uint64_t)1 << sizeLog2) - 1;
+    return true;
+}
+
+void clearTT2D() {
+    if (tt2D != NULL) memset(tt2D, 0, (size_t)(ttMask2D + 1) * sizeof(TTSlot2D));
+}
+
+void freeTT2D() {
+    free(tt2D);
+    tt2D = NULL;
+    ttMask2D = 0;
+}
+
+// Packed data word: score (16 bits) | depth (8) | flag (8) | best move + 1 (8)
+static uint64_t packTT2D(int score, int depth, int flag, int bestMove) {
+    return (uint64_t)(uint16_t)score | (uint64_t)(uint8_t)depth << 16 |
+           (uint64_t)(uint8_t)flag << 24 | (uint64_t)(uint8_t)(bestMove + 1) << 32;
+}
+
+static bool probeTT2D(uint64_t key, TTEntry2D *out) {
+    if (tt2D == NULL) return false;
+    TTSlot2D *slot = &tt2D[key & ttMask2D];
+    uint64_t data = atomic_load_explicit(&slot->data, memory_order_relaxed);
+    uint64_t check = atomic_load_explicit(&slot->keyXorData, memory_order_relaxed);
+    if ((check ^ data) != key) return false;
+    out->score = (int16_t)(data & 0xFFFF);
+    out->depth = (int)((data >> 16) & 0xFF);
+    out->flag = (int)((data >> 24) & 0xFF);
+    out->bestMove = (int)((data >> 32) & 0xFF) - 1;
+    return out->flag != TT_EMPTY;
+}
+
+// Keeps the deeper result when the slot already holds the same position
+static void storeTT2D(uint64_t key, int depth, int score, int flag, int bestMove) {
+    if (tt2D == NULL) return;
+    TTSlot2D *slot = &tt2D[key & ttMask2D];
+    TTEntry2D old;
+    if (probeTT2D(key, &old) && old.depth > depth) return;
+    uint64_t data = packTT2D(score, depth, flag, bestMove);
+    atomic_store_explicit(&slot->data, data, memory_order_relaxed);
+    atomic_store_explicit(&slot->keyXorData, key ^ data, memory_order_relaxed);
+}
+
+// Win scores carry the remaining depth (faster wins score higher). Store them
+// relative to the node so an entry stays valid when reached at another depth.
+// Relative win scores drop below WIN_SCORE (by up to the search depth), so they
+// are recognised against half of it; every other score is 0.
+#define WIN_THRESHOLD (WIN_SCORE / 2)
+
+static int scoreToTT2D(int score, int depth) {
+    if (score >= WIN_THRESHOLD) return score - depth;
+    if (score <= -WIN_THRESHOLD) return score + depth;
+    return score;
+}
+
+static int scoreFromTT2D(int score, int depth) {
+    if (score >= WIN_THRESHOLD) return score + depth;
+    if (score <= -WIN_THRESHOLD) return score - depth;
+    return score;
+}
+
+// Fills order[] with the TT move first (if any), then columns from the center outwards
+static void orderMoves2D(int ttMove, int order[COLS]) {
+    int n = 0;
+    if (ttMove >= 0 && ttMove < COLS) order[n++] = ttMove;
+    for (int i = 0; i < COLS; i++) {
+        int offset = (i + 1) / 2;
+        int c = COLS / 2 + ((i % 2) ? -offset : offset);
+        if (c != ttMove) order[n++] = c;
+    }
+}
+
+// ----------------------- SEARCH -----------------------
+
+#define TIME_CHECK_INTERVAL 1024 // Nodes between clock reads
+
+// Monotonic wall clock in milliseconds
+static double nowMs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+int evaluateBoard2D(const Board2D *b) {
+    if (winningMove2D(b, AI)) return WIN_SCORE;
+    if (winningMove2D(b, PLAYER)) return -WIN_SCORE;
+    return 0;
+}
+
+// Hooks for the shared alpha-beta core (alphaBeta.h)
+
+// Counts the node and its depth, and checks the clock, the node limit and the stop flag
+// every TIME_CHECK_INTERVAL nodes
+static inline bool enterNode2D(Search2D *s) {
+    SearchShared2D *shared = s->shared;
+    int ply = s->pos.moves - s->rootMoves; // The AI's root move is ply 1
+    if (ply > s->stats.maxDepth) s->stats.maxDepth = ply;
+    if ((++s->nodes % TIME_CHECK_INTERVAL) == 0) {
+        long long total = atomic_fetch_add_explicit(&shared->progress->nodes, TIME_CHECK_INTERVAL, memory_order_relaxed)
+                        + TIME_CHECK_INTERVAL;
+        if (nowMs() >= shared->deadlineMs || (shared->maxNodes > 0 && total >= shared->maxNodes) ||
+            atomic_load_explicit(&shared->progress->stop, memory_order_relaxed))
+            atomic_store(&shared->aborted, true);
+    }
+    return atomic_load_explicit(&shared->aborted, memory_order_relaxed);
+}
+
+static inline bool terminal2D(Search2D *s, int depth, int *score) {
+    const Board2D *b = &s->pos;
+    if (winningMove2D(b, PLAYER)) { *score = -WIN_SCORE - depth; return true; }
+    if (winningMove2D(b, AI)) { *score = WIN_SCORE + depth; return true; }
+    if (isFull2D(b)) { *score = 0; return true; }
+    if (depth == 0) { *score = evaluateBoard2D(b); return true; }
+    return false;
+}
+
+// Every node scores from the AI's point of view, so a root score another
+// thread has already reached is a valid alpha anywhere in this subtree.
+// It is clamped below beta so the window never becomes empty.
+static inline void raiseToRootAlpha2D(Search2D *s, int *alpha, int beta) {
+    int rootAlpha = atomic_load_explicit(&s->shared->rootAlpha, memory_order_relaxed);
+    if (rootAlpha > *alpha) *alpha = rootAlpha < beta ? rootAlpha : beta - 1;
+}
+
+static inline int genMoves2D(const Board2D *b, int ttMove, int moves[COLS]) {
+    int order[COLS];
+    orderMoves2D(ttMove, order);
+    int count = 0;
+    for (int i = 0; i < COLS; i++) {
+        if (isValidMove2D(b, order[i])) moves[count++] = order[i];
+    }
+    return count;
+}
+
+static inline bool probeNode2D(uint64_t key, int depth, AlphaBetaHit *hit) {
+    TTEntry2D entry;
+    if (!probeTT2D(key, &entry)) return false;
+    *hit = (AlphaBetaHit){ scoreFromTT2D(entry.score, depth), entry.depth, entry.flag, entry.bestMove };
+    return true;
+}
+
+// minimax2D(s, depth, alpha, beta, maximizing)
+#define AB_NAME minimax2D
+#define AB_STATE Search2D
+#define AB_MAX_MOVES COLS
+#define AB_TERMINAL(s, depth, out) terminal2D(s, depth, out)
+#define AB_GEN_MOVES(s, depth, maximizing, ttMove, moves) genMoves2D(&(s)->pos, ttMove, moves)
+#define AB_MAKE(s, move, maximizing) (makeMove2D(&(s)->pos, move, (maximizing) ? AI : PLAYER), false)
+#define AB_UNDO(s, move, maximizing) undoMove2D(&(s)->pos, move)
+#define AB_ENTER(s) enterNode2D(s)
+#define AB_ABORTED(s) atomic_load_explicit(&(s)->shared->aborted, memory_order_relaxed)
+#define AB_ADJUST_WINDOW(s, alpha, beta) raiseToRootAlpha2D(s, &(alpha), beta)
+#define AB_TT_KEY_TYPE uint64_t
+#define AB_TT_KEY(s) ((s)->pos.hash)
+#define AB_TT_PROBE(s, key, depth, hit) probeNode2D(key, depth, hit)
+#define AB_TT_STORE(s, key, depth, score, bound, move) storeTT2D(key, depth, scoreToTT2D(score, depth), bound, move)
+#define AB_STATS(s) (&(s)->stats)
+#include "alphaBeta.h"
+
+// One root move of the current iteration. Worker threads pull jobs until none are left.
+typedef struct {
+    const Board2D *root;
+    SearchShared2D *shared;
+    const int *moves;
+    int moveCount;
+    int depth;
+    atomic_int nextMove;
+} RootJobs2D;
+
+// Searches root moves against a private copy of the position, publishing every
+// move that beats the best score so far and raising the shared alpha with it.
+static void *rootWorker2D(void *arg) {
+    RootJobs2D *jobs = arg;
+    SearchShared2D *shared = jobs->shared;
+    Search2D s = { .pos = *jobs->root, .rootMoves = jobs->root->moves, .nodes = 0, .shared = shared };
+
+    for (;;) {
+        int i = atomic_fetch_add(&jobs->nextMove, 1);
+        if (i >= jobs->moveCount || atomic_load(&shared->aborted)) break;
+        int c = jobs->moves[i];
+
+        // We call minimax for the minimizing player (false) because it's evaluating the state *after* AI moves,
+        // anticipating the player's response. A move that cannot beat the shared alpha fails low, which is all
+        // the root needs to know.
+        makeMove2D(&s.pos, c, AI);
+        int score = minimax2D(&s, jobs->depth, atomic_load(&shared->rootAlpha), INT_MAX, false);
+        undoMove2D(&s.pos, c);
+        if (atomic_load(&shared->aborted)) break;
+
+        // Only a strictly better score is taken: it lies above every alpha this search
+        // used, so it is exact. Equal scores may be fail-low bounds and are ignored.
+        pthread_mutex_lock(&shared->lock);
+        if (shared->bestCol == -1 || score > shared->bestScore) {
+            shared->bestScore = score;
+            shared->bestCol = c;
+            atomic_store(&shared->rootAlpha, score);
+        }
+        pthread_mutex_unlock(&shared->lock);
+    }
+
+    // Nodes not yet published by minimax2D's periodic flush
+    atomic_fetch_add(&shared->progress->nodes, s.nodes % TIME_CHECK_INTERVAL);
+    s.stats.nodes = s.nodes;
+    pthread_mutex_lock(&shared->lock);
+    addSearchStats(&shared->stats, &s.stats);
+    pthread_mutex_unlock(&shared->lock);
+    return NULL;
+}
+
+// Searches every AI move with `depth` plies of reply below it. pvMove is tried first.
+// Returns the best column and its score, or -1 if the search ran out of time.
+int searchRoot2D(const Board2D *root, int depth, int pvMove, int *bestScore, SearchShared2D *shared) {
+    // The previous iteration's best move goes first, then the table's move for this position
+    TTEntry2D entry;
+    int ttMove = probeTT2D(root->hash, &entry) ? entry.bestMove : -1;
+    int order[COLS];
+    orderMoves2D(pvMove != -1 ? pvMove : ttMove, order);
+
+    int moves[COLS];
+    int moveCount = 0;
+    Board2D probe = *root;
+    for (int i = 0; i < COLS; i++) {
+        int c = order[i];
+        if (isValidMove2D(root, c)) {
+            // Check for immediate AI win
+            makeMove2D(&probe, c, AI);
+            bool wins = winningMove2D(&probe, AI);
+            undoMove2D(&probe, c);
+            if (wins) {
+                *bestScore = WIN_SCORE + depth;
+                return c; // Immediate win is the best move
+            }
+            moves[moveCount++] = c;
+        }
+    }
+    if (moveCount == 0) return -1;
+
+    shared->bestCol = -1;
+    shared->bestScore = INT_MIN;
+    atomic_store(&shared->rootAlpha, INT_MIN);
+
+    RootJobs2D jobs = { .root = root, .shared = shared, .moves = moves, .moveCount = moveCount, .depth = depth };
+    atomic_init(&jobs.nextMove, 0);
+
+    // One worker per root move up to searchThreads; the calling thread is one of them
+    int workers = searchThreads < moveCount ? searchThreads : moveCount;
+    pthread_t threads[COLS];
+    int started = 0;
+    for (int i = 1; i < workers; i++) {
+        if (pthread_create(&threads[started], NULL, rootWorker2D, &jobs) == 0) started++;
+    }
+    rootWorker2D(&jobs);
+    for (int i = 0; i < started; i++) pthread_join(threads[i], NULL);
+
+    if (atomic_load(&shared->aborted)) return -1;
+
+    *bestScore = shared->bestScore;
+    storeTT2D(root->hash, depth + 1, scoreToTT2D(*bestScore, depth + 1), TT_EXACT, shared->bestCol);
+    return shared->bestCol;
+}
+
+// Expected line after the AI plays firstCol: the move itself, then the table's best
+// move in each following position until the table runs out, a move wins, the board fills
+// or the line is as long as the iteration that produced it (deeper entries are stale)
+static int collectPV2D(const Board2D *root, int firstCol, int depth, int pv[SEARCH_MAX_PV]) {
+    Board2D pos = *root;
+    int length = 0;
+    int col = firstCol, piece = AI;
+    while (length < depth && length < SEARCH_MAX_PV && isValidMove2D(&pos, col)) {
+        makeMove2D(&pos, col, piece);
+        pv[length++] = col;
+        TTEntry2D entry;
+        if (winningMove2D(&pos, piece) || isFull2D(&pos) || !probeTT2D(pos.hash, &entry)) break;
+        col = entry.bestMove;
+        piece = (piece == AI) ? PLAYER : AI;
+    }
+    return length;
+}
+
+// Iterative deepening: searches 1, 2, ... up to maxDepth + 1 plies until a limit is hit
+// (or progress->stop is set), and returns the best move of the last iteration that
+// finished, -1 if none did. Each finished iteration is reported to onInfo if given.
+static int deepen2D(const Board2D *root, int maxDepth, double deadlineMs, long long maxNodes,
+                    SearchProgress2D *progress, SearchInfoCallback onInfo, void *ctx) {
+    double startMs = nowMs();
+    atomic_store(&progress->depth, 0);
+    atomic_store(&progress->nodes, 0);
+
+    SearchShared2D shared;
+    shared.deadlineMs = deadlineMs;
+    shared.maxNodes = maxNodes;
+    shared.progress = progress;
+    atomic_init(&shared.aborted, atomic_load(&progress->stop));
+    atomic_init(&shared.rootAlpha, INT_MIN);
+    pthread_mutex_init(&shared.lock, NULL);
+    shared.stats = (SearchStats){ 0 };
+
+    int bestCol = -1;
+    for (int depth = 0; depth <= maxDepth; depth++) {
+        int score;
+        int col = searchRoot2D(root, depth, bestCol, &score, &shared);
+        if (col == -1) break;
+        bestCol = col;
+        atomic_store(&progress->depth, depth + 1);
+        if (onInfo != NULL) {
+            SearchInfo info = { .depth = depth + 1, .score = score, .nodes = atomic_load(&progress->nodes),
+                                .timeMs = nowMs() - startMs };
+            info.pvLength = collectPV2D(root, col, depth + 1, info.pv);
+            onInfo(&info, ctx);
+        }
+        // A forced win or loss inside the horizon will not change with more depth
+        if (score >= WIN_SCORE || score <= -WIN_SCORE) break;
+    }
+    pthread_mutex_destroy(&shared.lock);
+    progress->stats = shared.stats;
+    progress->stats.timeMs = nowMs() - startMs;
+    return bestCol;
+}
+
+// Most central free column, for when no iteration finished in time
+static int fallbackMove2D(const Board2D *root) {
+    int order[COLS];
+    orderMoves2D(-1, order);
+    for (int i = 0; i < COLS; i++) {
+        if (isValidMove2D(root, order[i])) return order[i];
+    }
+    return -1;
+}
+
+// Searches up to `difficulty2D` until moveTimeMs2D runs out (or progress->stop is set), and
+// plays the best move of the last iteration that finished. progress may be NULL;
+// otherwise its depth and node counters are reset and kept up to date.
+int getBestMove2D(const Board2D *root, SearchProgress2D *progress) {
+    SearchProgress2D localProgress;
+    if (progress == NULL) {
+        progress = &localProgress;
+        atomic_init(&progress->stop, false);
+    }
+
+    int bestCol = deepen2D(root, difficulty2D, nowMs() + moveTimeMs2D, 0, progress, NULL, NULL);
+    return bestCol != -1 ? bestCol : fallbackMove2D(root);
+}
+
+// The same search under the text protocol's limits, ignoring difficulty2D and moveTimeMs2D:
+// up to limits->depth plies (the AI's move included), all empty cells if 0
+int getBestMove2DLimited(const Board2D *root, const SearchLimits *limits, SearchInfoCallback onInfo, void *ctx) {
+    SearchProgress2D progress;
+    atomic_init(&progress.stop, false);
+    int empty = ROWS * COLS - root->moves;
+    int plies = (limits->depth > 0 && limits->depth < empty) ? limits->depth : empty;
+    double deadlineMs = limits->timeMs > 0 ? nowMs() + limits->timeMs : DBL_MAX;
+
+    int bestCol = deepen2D(root, plies - 1, deadlineMs, limits->nodes, &progress, onInfo, ctx);
+    return bestCol != -1 ? bestCol : fallbackMove2D(root);
+}
+
+// ----------------------- AI WORKER -----------------------
+
+static void *aiWorkerMain(void *arg) {
+    AIWorker2D *w = arg;
+    w->resultCol = getBestMove2D(&w->position, &w->progress);
+    atomic_store(&w->done, true);
+    return NULL;
+}
+
+// Starts searching a copy of position in the background. Returns false if the thread could not be created.
+bool startAIWorker(const Board2D *position) {
+    aiWorker2D.position = *position;
+    aiWorker2D.resultCol = -1;
+    atomic_store(&aiWorker2D.progress.depth, 0);
+    atomic_store(&aiWorker2D.progress.nodes, 0);
+    atomic_store(&aiWorker2D.progress.stop, false);
+    atomic_store(&aiWorker2D.done, false);
+    aiWorker2D.running = pthread_create(&aiWorker2D.thread, NULL, aiWorkerMain, &aiWorker2D) == 0;
+    return aiWorker2D.running;
+}
+
+// Non-blocking: returns true (and joins the thread) once the worker has a move
+bool pollAIWorker(int *col) {
+    if (!aiWorker2D.running || !atomic_load(&aiWorker2D.done)) return false;
+    pthread_join(aiWorker2D.thread, NULL);
+    aiWorker2D.running = false;
+    *col = aiWorker2D.resultCol;
+    return true;
+}
+
+// Asks a running search to stop and waits for it, discarding its move
+void stopAIWorker() {
+    if (!aiWorker2D.running) return;
+    atomic_store(&aiWorker2D.progress.stop, true);
+    pthread_join(aiWorker2D.thread, NULL);
+    aiWorker2D.running = false;
+}
@@ -0,0 +1,90 @@
+// twoDConnectFourEngine.h - Board, rules and AI for 2D Connect Four
+//
+// Headless: nothing here depends on raylib. Positions are Board2D values owned by
+// the caller; the search settings, the transposition table and the background
+// worker are globals, one game per process.
+
+#ifndef TWOD_CONNECT_FOUR_ENGINE_H
+#define TWOD_CONNECT_FOUR_ENGINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "searchInfo.h"
+
+// Define constants
+#define ROWS 6
+#define COLS 7
+#define PLAYER 1
+#define AI 2
+#define EMPTY 0
+#define WIN_SCORE 100
+
+// Search settings, read at the start of every AI move
+extern int difficulty2D;  // Maximum search depth
+extern int moveTimeMs2D;  // Wall-clock budget per AI move; the last fully searched depth is played
+extern int searchThreads; // Root moves searched in parallel; 1 searches them one after another
+
+// Bitboard layout: column-major, ROWS + 1 bits per column. The extra top bit of
+// each column is a sentinel that is never set, so shifted lines cannot wrap into
+// the next column. Bit index = col * BB_COL_HEIGHT + h, with h = 0 the bottom row.
+#define BB_COL_HEIGHT (ROWS + 1)
+#define BB_BIT(col, h) (1ULL << ((col) * BB_COL_HEIGHT + (h)))
+
+// Define the 2D board. Plain value type: copying it gives an independent position.
+typedef struct {
+    uint64_t stones[3]; // One mask per piece, indexed by PLAYER / AI (slot 0 unused)
+    int height[COLS];   // Number of pieces already dropped in each column
+    int moves;          // Total number of pieces on the board
+    uint64_t hash;      // Zobrist hash of the position and side to move, updated by make/undo
+} Board2D;
+
+// Default table size as a power of two (2^20 entries * 16 bytes = 16 MB)
+#define TT_DEFAULT_SIZE_LOG2 20
+
+// Live view of a running search. The caller may read it from another thread
+// while getBestMove2D runs, and set `stop` to make the search return early.
+typedef struct {
+    atomic_int depth;    // Plies of the deepest finished iteration, 0 before the first
+    atomic_llong nodes;  // Nodes searched so far for this move
+    atomic_bool stop;    // Set by the caller to abandon the search
+    SearchStats stats;   // Written when the search returns; read it only after that
+} SearchProgress2D;
+
+// Background AI search, so the window keeps rendering while the AI thinks
+typedef struct {
+    pthread_t thread;
+    Board2D position;          // Snapshot of the board the worker searches
+    SearchProgress2D progress; // Read by the renderer every frame
+    atomic_bool done;          // Set by the worker once resultCol is valid
+    int resultCol;
+    bool running;
+} AIWorker2D;
+
+extern AIWorker2D aiWorker2D;
+
+bool isValidMove2D(const Board2D *b, int col);
+int makeMove2D(Board2D *b, int col, int piece);
+void undoMove2D(Board2D *b, int col);
+bool winningMove2D(const Board2D *b, int piece);
+int cellAt2D(const Board2D *b, int r, int c);
+bool isFull2D(const Board2D *b);
+int evaluateBoard2D(const Board2D *b);
+
+// Call initZobrist2D once before any move is made; without initTT2D the search runs without a table
+void initZobrist2D();
+bool initTT2D(int sizeLog2);
+void clearTT2D();
+void freeTT2D();
+
+// Best column for AI in root, or -1. progress may be NULL
+int getBestMove2D(const Board2D *root, SearchProgress2D *progress);
+int getBestMove2DLimited(const Board2D *root, const SearchLimits *limits, SearchInfoCallback onInfo, void *ctx);
+
+// Background search: start, then poll once per frame until it returns true; stop cancels
+bool startAIWorker(const Board2D *position);
+bool pollAIWorker(int *col);
+void stopAIWorker();
+
+#endif // TWOD_CONNECT_FOUR_ENGINE_H
@@ -0,0 +1,437 @@
+// twoDTicTacToeEngine.c - Board, rules and AI for 2D Tic-Tac-Toe (no raylib)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <time.h>
+#include "twoDTicTacToeEngine.h"
+#include "alphaBeta.h" // Shared search core
+
+#define NUM_CODES 19683 // 3^NUM_CELLS board encodings
+
+char board[SIZE][SIZE];
+int difficulty = 3; // Default to hard
+char playerSymbol = ' '; // Player selects X or O
+char aiSymbol = ' ';
+SearchStats searchStats; // Work of the last AIMove or FindBestMove
+
+// --- Precomputed Move Tables ---
+// Boards are encoded in base 3: cell i = row * SIZE + col contributes
+// 3^i * (0 empty, 1 'X', 2 'O'). For every position that can occur the tables
+// hold the value FindBestMove would compute and the set of equally best moves.
+typedef struct {
+    signed char value;       // Score of the best move for the side to move
+    unsigned short bestMask; // Bit i set if cell i is one of the best moves; 0 if no entry
+} MoveTableEntry;
+
+MoveTableEntry mediumTable[NUM_CODES]; // Same depth limit as FindBestMove on medium (maxDepth 3)
+MoveTableEntry hardTable[NUM_CODES];   // Full depth (maxDepth 9): perfect play
+
+// AlphaBeta searches the global board; this tracks the plies played since the AI's root move,
+// the limits of FindBestMoveLimited (0 for none) and the principal variation of each ply
+typedef struct {
+    int ply;
+    long long nodes;
+    long long maxNodes;
+    double deadlineMs;
+    bool aborted;                          // A limit was hit; every node unwinds
+    SearchStats stats;
+    int pv[NUM_CELLS + 1][NUM_CELLS];      // pv[ply]: best line found from that ply on
+    int pvLength[NUM_CELLS + 1];
+} SearchState;
+
+#define TIME_CHECK_INTERVAL 1024 // Nodes between clock reads
+
+int AlphaBeta(SearchState *s, int depth, int alpha, int beta, bool isMax);
+
+// --- Game Logic Functions ---
+
+void InitializeBoard() {
+    for (int i = 0; i < SIZE; i++)
+        for (int j = 0; j < SIZE; j++)
+            board[i][j] = ' ';
+}
+
+int IsMovesLeft() {
+    for (int i = 0; i < SIZE; i++)
+        for (int j = 0; j < SIZE; j++)
+            if (board[i][j] == ' ')
+                return 1;
+    return 0;
+}
+
+char CheckWinner() {
+    // Rows and Columns
+    for (int i = 0; i < SIZE; i++) {
+        if (board[i][0] != ' ' && board[i][0] == board[i][1] && board[i][1] == board[i][2]) return board[i][0];
+        if (board[0][i] != ' ' && board[0][i] == board[1][i] && board[1][i] == board[2][i]) return board[0][i];
+    }
+    // Diagonals
+    if (board[0][0] != ' ' && board[0][0] == board[1][1] && board[1][1] == board[2][2]) return board[0][0];
+    if (board[0][2] != ' ' && board[0][2] == board[1][1] && board[1][1] == board[2][0]) return board[0][2];
+
+    return ' '; // No winner
+}
+
+int Evaluate() {
+    char winner = CheckWinner();
+    if (winner == aiSymbol) return 10;      // Use aiSymbol
+    else if (winner == playerSymbol) return -10; // Use playerSymbol
+    return 0; // Draw or ongoing
+}
+
+// Monotonic wall clock in milliseconds
+static double nowMs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// Hooks for the shared alpha-beta core (alphaBeta.h)
+
+// Counts the node and its depth, starts its line empty and checks the limits (the clock
+// only every TIME_CHECK_INTERVAL nodes); true once the search must unwind
+static inline bool EnterNode(SearchState *s) {
+    s->pvLength[s->ply] = 0;
+    s->nodes++;
+    if (s->ply + 1 > s->stats.maxDepth) s->stats.maxDepth = s->ply + 1; // The AI's root move is ply 1
+    if (s->maxNodes > 0 && s->nodes >= s->maxNodes) s->aborted = true;
+    if (s->deadlineMs > 0 && s->nodes % TIME_CHECK_INTERVAL == 0 && nowMs() >= s->deadlineMs) s->aborted = true;
+    return s->aborted;
+}
+
+static inline bool Terminal(const SearchState *s, int depth, int *score) {
+    int result = Evaluate();
+    if (result == 10) { *score = result - s->ply; return true; } // AI wins
+    if (result == -10) { *score = result + s->ply; return true; } // Human wins
+    if (!IsMovesLeft() || depth <= 0) { *score = 0; return true; } // Draw or depth limit
+    return false;
+}
+
+// Empty cells (row * SIZE + col) in board order
+static inline int EmptyCells(int moves[NUM_CELLS]) {
+    int count = 0;
+    for (int cell = 0; cell < NUM_CELLS; cell++)
+        if (board[cell / SIZE][cell % SIZE] == ' ') moves[count++] = cell;
+    return count;
+}
+
+static inline void PlaceSymbol(SearchState *s, int cell, bool isMax) {
+    board[cell / SIZE][cell % SIZE] = isMax ? aiSymbol : playerSymbol;
+    s->ply++;
+}
+
+static inline void ClearCell(SearchState *s, int cell) {
+    board[cell / SIZE][cell % SIZE] = ' ';
+    s->ply--;
+}
+
+// The line from this ply is the move followed by the child's line
+static inline void UpdatePV(SearchState *s, int cell, bool searched) {
+    int childLength = searched ? s->pvLength[s->ply + 1] : 0;
+    s->pv[s->ply][0] = cell;
+    memcpy(&s->pv[s->ply][1], s->pv[s->ply + 1], childLength * sizeof(int));
+    s->pvLength[s->ply] = 1 + childLength;
+}
+
+// Minimax with Alpha-Beta Pruning: AlphaBeta(s, depth, alpha, beta, isMax), depth = plies left
+#define AB_NAME AlphaBeta
+#define AB_STATE SearchState
+#define AB_MAX_MOVES NUM_CELLS
+#define AB_TERMINAL(s, depth, out) Terminal(s, depth, out)
+#define AB_GEN_MOVES(s, depth, isMax, ttMove, moves) EmptyCells(moves)
+#define AB_MAKE(s, cell, isMax) (PlaceSymbol(s, cell, isMax), false)
+#define AB_UNDO(s, cell, isMax) ClearCell(s, cell)
+#define AB_ENTER(s) EnterNode(s)
+#define AB_ABORTED(s) ((s)->aborted)
+#define AB_PV_UPDATE(s, cell, searched) UpdatePV(s, cell, searched)
+#define AB_STATS(s) (&(s)->stats)
+#include "alphaBeta.h"
+
+void FindBestMove(int *bestRow, int *bestCol) {
+    int bestVal = INT_MIN;
+    *bestRow = -1;
+    *bestCol = -1;
+    // Adjust maxDepth based on difficulty (more moves explored for harder levels)
+    int maxDepth = (difficulty == 1) ? 1 : (difficulty == 2) ? 3 : 9;
+
+    // --- Randomness for equivalent best moves ---
+    typedef struct { int r, c; } Move;
+    Move bestMoves[SIZE*SIZE];
+    int numBestMoves = 0;
+    // --- End Randomness ---
+    searchStats = (SearchStats){ 0 };
+    double startMs = nowMs();
+
+
+    for (int i = 0; i < SIZE; i++) {
+        for (int j = 0; j < SIZE; j++) {
+            if (board[i][j] == ' ') {
+                board[i][j] = aiSymbol; // Use aiSymbol
+                // Use AlphaBeta directly here for evaluation
+                SearchState state = { 0 };
+                int moveVal = AlphaBeta(&state, maxDepth, INT_MIN, INT_MAX, false);
+                state.stats.nodes = state.nodes;
+                addSearchStats(&searchStats, &state.stats);
+                board[i][j] = ' '; // Undo move
+
+                if (moveVal > bestVal) {
+                    bestVal = moveVal;
+                    // Reset best moves list
+                    numBestMoves = 0;
+                    bestMoves[numBestMoves++] = (Move){i, j};
+                } else if (moveVal == bestVal) {
+                    // Add to list of equally good moves
+                    if (numBestMoves < SIZE*SIZE) { // Basic bounds check
+                         bestMoves[numBestMoves++] = (Move){i, j};
+                    }
+                }
+            }
+        }
+    }
+
+    searchStats.timeMs = nowMs() - startMs;
+
+    // Select randomly from the best moves found
+    if (numBestMoves > 0) {
+        int randomIndex = rand() % numBestMoves;
+        *bestRow = bestMoves[randomIndex].r;
+        *bestCol = bestMoves[randomIndex].c;
+    } else {
+        // Fallback: if no move evaluated (shouldn't happen if moves left), pick first available
+        for (int i = 0; i < SIZE; i++) {
+            for (int j = 0; j < SIZE; j++) {
+                if (board[i][j] == ' ') {
+                    *bestRow = i;
+                    *bestCol = j;
+                    return;
+                }
+            }
+        }
+    }
+}
+
+// Iterative deepening for the text protocol: searches 1, 2, ... plies (the AI's move
+// included) until limits->depth or the board is exhausted, or a node or time limit
+// stops it, and reports each finished iteration to onInfo (which may be NULL).
+// Deterministic: ties keep the first move in board order. Returns false if no
+// iteration finished; the move is then the first empty cell, or -1 on a full board.
+bool FindBestMoveLimited(const SearchLimits *limits, SearchInfoCallback onInfo, void *ctx, int *bestRow, int *bestCol) {
+    double startMs = nowMs();
+    int emptyCount = 0, firstEmpty = -1;
+    for (int cell = 0; cell < NUM_CELLS; cell++) {
+        if (board[cell / SIZE][cell % SIZE] == ' ') {
+            if (firstEmpty == -1) firstEmpty = cell;
+            emptyCount++;
+        }
+    }
+    *bestRow = firstEmpty == -1 ? -1 : firstEmpty / SIZE;
+    *bestCol = firstEmpty == -1 ? -1 : firstEmpty % SIZE;
+    int maxDepth = (limits->depth > 0 && limits->depth < emptyCount) ? limits->depth : emptyCount;
+
+    SearchState s = { .maxNodes = limits->nodes, .deadlineMs = limits->timeMs > 0 ? startMs + limits->timeMs : 0 };
+
+    bool found = false;
+    for (int depth = 1; depth <= maxDepth; depth++) {
+        int bestVal = INT_MIN, bestCell = -1;
+        SearchInfo info = { .depth = depth };
+        for (int cell = 0; cell < NUM_CELLS && !s.aborted; cell++) {
+            if (board[cell / SIZE][cell % SIZE] != ' ') continue;
+            board[cell / SIZE][cell % SIZE] = aiSymbol;
+            // A move that cannot beat the best so far fails low; only strictly better scores are exact
+            int moveVal = AlphaBeta(&s, depth - 1, bestVal, INT_MAX, false);
+            board[cell / SIZE][cell % SIZE] = ' ';
+            if (!s.aborted && moveVal > bestVal) {
+                bestVal = moveVal;
+                bestCell = cell;
+                info.pv[0] = cell;
+                memcpy(&info.pv[1], s.pv[0], s.pvLength[0] * sizeof(int));
+                info.pvLength = 1 + s.pvLength[0];
+            }
+        }
+        if (s.aborted || bestCell == -1) break;
+
+        *bestRow = bestCell / SIZE;
+        *bestCol = bestCell % SIZE;
+        found = true;
+        info.score = bestVal;
+        info.nodes = s.nodes;
+        info.timeMs = nowMs() - startMs;
+        if (onInfo != NULL) onInfo(&info, ctx);
+        if (bestVal != 0) break; // A forced win or loss will not change with more depth
+    }
+    return found;
+}
+
+// --- Move Table Generation ---
+
+static const int POW3[NUM_CELLS] = { 1, 3, 9, 27, 81, 243, 729, 2187, 6561 };
+
+int EncodeBoard() {
+    int code = 0;
+    for (int i = 0; i < NUM_CELLS; i++) {
+        char cell = board[i / SIZE][i % SIZE];
+        code += POW3[i] * (cell == 'X' ? 1 : cell == 'O' ? 2 : 0);
+    }
+    return code;
+}
+
+static int CellOfCode(int code, int i) {
+    return (code / POW3[i]) % 3;
+}
+
+// Winner of an encoded board: 1 ('X'), 2 ('O') or 0
+static int CodeWinner(int code) {
+    static const int lines[8][3] = {
+        {0, 1, 2}, {3, 4, 5}, {6, 7, 8}, // Rows
+        {0, 3, 6}, {1, 4, 7}, {2, 5, 8}, // Columns
+        {0, 4, 8}, {2, 4, 6}             // Diagonals
+    };
+    for (int l = 0; l < 8; l++) {
+        int a = CellOfCode(code, lines[l][0]);
+        if (a != 0 && a == CellOfCode(code, lines[l][1]) && a == CellOfCode(code, lines[l][2])) return a;
+    }
+    return 0;
+}
+
+// Value of `code` for the player who just moved into it, as AlphaBeta scores it at ply 0
+// with `pliesLeft` plies before its depth limit. Scores are relative: each ply between the
+// move and a win takes one point off, exactly like AlphaBeta's "score - ply". memo caches
+// results per (code, pliesLeft); SCHAR_MAX marks an empty slot.
+static int SolveCode(int code, int pliesLeft, signed char (*memo)[NUM_CELLS + 1]) {
+    if (memo[code][pliesLeft] != SCHAR_MAX) return memo[code][pliesLeft];
+
+    int xCount = 0, oCount = 0;
+    for (int i = 0; i < NUM_CELLS; i++) {
+        int cell = CellOfCode(code, i);
+        if (cell == 1) xCount++; else if (cell == 2) oCount++;
+    }
+
+    int value;
+    if (CodeWinner(code) != 0) {
+        value = 10; // Only the player who just moved can have completed a line
+    } else if (xCount + oCount == NUM_CELLS || pliesLeft <= 0) {
+        value = 0;  // Draw or depth limit
+    } else {
+        // The opponent replies with its best move; its gain is our loss, one ply further away
+        int toMove = (xCount == oCount) ? 1 : 2;
+        int bestReply = INT_MIN;
+        for (int i = 0; i < NUM_CELLS; i++) {
+            if (CellOfCode(code, i) == 0) {
+                int reply = SolveCode(code + toMove * POW3[i], pliesLeft - 1, memo);
+                if (reply > bestReply) bestReply = reply;
+            }
+        }
+        value = -bestReply + (bestReply > 0) - (bestReply < 0);
+    }
+
+    memo[code][pliesLeft] = (signed char)value;
+    return value;
+}
+
+// Fills one table with FindBestMove's results at the given depth limit for every reachable position
+static void FillMoveTable(MoveTableEntry *table, int maxDepth, signed char (*memo)[NUM_CELLS + 1]) {
+    for (int code = 0; code < NUM_CODES; code++) {
+        table[code].value = 0;
+        table[code].bestMask = 0;
+
+        int xCount = 0, oCount = 0;
+        for (int i = 0; i < NUM_CELLS; i++) {
+            int cell = CellOfCode(code, i);
+            if (cell == 1) xCount++; else if (cell == 2) oCount++;
+        }
+        // 'X' always moves first; skip unreachable, finished and full boards
+        if (xCount != oCount && xCount != oCount + 1) continue;
+        if (xCount + oCount == NUM_CELLS || CodeWinner(code) != 0) continue;
+
+        int toMove = (xCount == oCount) ? 1 : 2;
+        int bestVal = INT_MIN;
+        for (int i = 0; i < NUM_CELLS; i++) {
+            if (CellOfCode(code, i) != 0) continue;
+            int val = SolveCode(code + toMove * POW3[i], maxDepth, memo);
+            if (val > bestVal) {
+                bestVal = val;
+                table[code].bestMask = 0;
+            }
+            if (val == bestVal) table[code].bestMask |= 1 << i;
+        }
+        table[code].value = (signed char)bestVal;
+    }
+}
+
+// Solves the whole game once at startup (about 4500 positions, ~10 ms for both tables),
+// so the AI never has to search during play
+void InitMoveTables() {
+    signed char (*memo)[NUM_CELLS + 1] = malloc(sizeof(signed char[NUM_CODES][NUM_CELLS + 1]));
+    if (memo == NULL) return; // Tables stay empty; AIMove falls back to FindBestMove
+
+    memset(memo, SCHAR_MAX, sizeof(signed char[NUM_CODES][NUM_CELLS + 1]));
+    FillMoveTable(mediumTable, 3, memo);
+    FillMoveTable(hardTable, 9, memo);
+    free(memo);
+}
+
+// O(1) replacement for FindBestMove: picks uniformly among the table's equally best moves
+bool LookupBestMove(int *row, int *col) {
+    const MoveTableEntry *entry = &(difficulty == 2 ? mediumTable : hardTable)[EncodeBoard()];
+    int count = 0;
+    for (int i = 0; i < NUM_CELLS; i++)
+        if (entry->bestMask & (1 << i)) count++;
+    if (count == 0) return false;
+
+    int pick = rand() % count;
+    for (int i = 0; i < NUM_CELLS; i++) {
+        if ((entry->bestMask & (1 << i)) && pick-- == 0) {
+            *row = i / SIZE;
+            *col = i % SIZE;
+            return true;
+        }
+    }
+    return false;
+}
+
+void MakeRandomMove(int *row, int *col) {
+    int emptyCells[SIZE * SIZE][2], count = 0;
+    for (int i = 0; i < SIZE; i++)
+        for (int j = 0; j < SIZE; j++)
+            if (board[i][j] == ' ') {
+                emptyCells[count][0] = i;
+                emptyCells[count][1] = j;
+                count++;
+            }
+    if (count > 0) {
+        int choice = rand() % count;
+        *row = emptyCells[choice][0];
+        *col = emptyCells[choice][1];
+    } else {
+        *row = -1; // Indicate no move possible
+        *col = -1;
+    }
+}
+
+void AIMove() {
+    int row = -1, col = -1;
+    searchStats = (SearchStats){ 0 }; // Stays empty for random and table moves
+    double startMs = nowMs();
+    if (difficulty == 1) { // Easy: Random move
+        MakeRandomMove(&row, &col);
+    } else { // Medium/Hard: Precomputed table, searching only if the position has no entry
+        if (!LookupBestMove(&row, &col) || board[row][col] != ' ') {
+            FindBestMove(&row, &col);
+        }
+    }
+    searchStats.timeMs = nowMs() - startMs;
+
+    // Ensure a valid move was found before placing
+    if (row != -1 && col != -1 && board[row][col] == ' ') {
+        board[row][col] = aiSymbol; // Use aiSymbol
+    } else if (IsMovesLeft()) {
+        // Fallback if AI logic failed but moves are available (should not happen often)
+        printf("AI Logic Error: Making random fallback move.\n"); // Corrected newline escape
+        MakeRandomMove(&row, &col);
+        if (row != -1 && col != -1) {
+             board[row][col] = aiSymbol; // Use aiSymbol
+        }
+    }
+}
@@ -0,0 +1,35 @@
+// twoDTicTacToeEngine.h - Board, rules and AI for 2D Tic-Tac-Toe
+//
+// Headless: nothing here depends on raylib, so the engine can be linked into the
+// raylib front end (twoDTicTacToe.c) or any command-line tool. The position and the
+// player settings are globals, one game per process.
+
+#ifndef TWOD_TIC_TAC_TOE_ENGINE_H
+#define TWOD_TIC_TAC_TOE_ENGINE_H
+
+#include <stdbool.h>
+#include "searchInfo.h"
+
+#define SIZE 3
+#define NUM_CELLS (SIZE * SIZE)
+
+extern char board[SIZE][SIZE]; // ' ', 'X' or 'O'
+extern int difficulty;         // 1 easy, 2 medium, 3 hard
+extern char playerSymbol;      // 'X' or 'O'
+extern char aiSymbol;
+extern SearchStats searchStats; // Work of the last AIMove or FindBestMove
+
+void InitializeBoard();
+int IsMovesLeft();
+char CheckWinner(); // 'X', 'O' or ' '
+int Evaluate();     // +10 AI won, -10 player won, 0 otherwise
+
+void FindBestMove(int *bestRow, int *bestCol); // Alpha-beta search at the difficulty's depth
+bool FindBestMoveLimited(const SearchLimits *limits, SearchInfoCallback onInfo, void *ctx, int *bestRow, int *bestCol);
+void MakeRandomMove(int *row, int *col);       // -1, -1 if the board is full
+int EncodeBoard();                             // Base-3 code of the board
+void InitMoveTables();                         // Solve the game once; call before AIMove
+bool LookupBestMove(int *row, int *col);       // Table lookup; false if no entry
+void AIMove();                                 // Plays aiSymbol's move on the board
+
+#endif // TWOD_TIC_TAC_TOE_ENGINE_H
@@ -0,0 +1,73 @@
+// searchStatsOverlay.h - AI search statistics overlay and log shared by the raylib front ends
+//
+// Each front end keeps the SearchStats of the AI's last move (see engine/searchInfo.h),
+// calls logSearchStats once per AI move and drawSearchStats every frame. The overlay
+// starts hidden; F3 shows and hides it. The log is plain text, one line per AI move,
+// appended to searchStats.log in the working directory.
+
+#ifndef SEARCH_STATS_OVERLAY_H
+#define SEARCH_STATS_OVERLAY_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <time.h>
+#include "include/raylib.h"
+#include "engine/searchInfo.h"
+
+#define SEARCH_STATS_KEY KEY_F3
+#define SEARCH_STATS_LOG_FILE "searchStats.log"
+#define SEARCH_STATS_FONT_SIZE 18
+#define SEARCH_STATS_LINES 7
+
+static bool searchStatsVisible = false;
+
+static double searchStatsPercent(long long part, long long whole) {
+    return whole > 0 ? 100.0 * part / whole : 0.0;
+}
+
+static void logSearchStats(const char *game, const SearchStats *stats) {
+    FILE *log = fopen(SEARCH_STATS_LOG_FILE, "a");
+    if (log == NULL) return; // Statistics are optional; the game goes on without them
+
+    char stamp[32];
+    time_t now = time(NULL);
+    strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", localtime(&now));
+    fprintf(log, "%s %s nodes=%lld leafEvals=%lld betaCutoffs=%lld firstMoveCutoffs=%.1f%% "
+                 "ttProbes=%lld ttHits=%lld (%.1f%%) maxDepth=%d timeMs=%.1f\n",
+            stamp, game, stats->nodes, stats->leafEvals, stats->betaCutoffs,
+            searchStatsPercent(stats->firstMoveCutoffs, stats->betaCutoffs),
+            stats->ttProbes, stats->ttHits, searchStatsPercent(stats->ttHits, stats->ttProbes),
+            stats->maxDepth, stats->timeMs);
+    fclose(log);
+}
+
+// Handles the toggle key too, so call it every frame between BeginDrawing and EndDrawing
+static void drawSearchStats(const SearchStats *stats, int x, int y, Color textColor, Color background) {
+    if (IsKeyPressed(SEARCH_STATS_KEY)) searchStatsVisible = !searchStatsVisible;
+    if (!searchStatsVisible) return;
+
+    long long nps = stats->timeMs > 0 ? (long long)(stats->nodes * 1000.0 / stats->timeMs) : 0;
+    char lines[SEARCH_STATS_LINES][64]; // Not TextFormat: it reuses a handful of static buffers
+    snprintf(lines[0], sizeof(lines[0]), "Last AI move  [F3]");
+    snprintf(lines[1], sizeof(lines[1]), "Nodes: %lld  (%lld nps)", stats->nodes, nps);
+    snprintf(lines[2], sizeof(lines[2]), "Leaf evals: %lld", stats->leafEvals);
+    snprintf(lines[3], sizeof(lines[3]), "Beta cutoffs: %lld  (%.1f%% first move)", stats->betaCutoffs,
+             searchStatsPercent(stats->firstMoveCutoffs, stats->betaCutoffs));
+    snprintf(lines[4], sizeof(lines[4]), "TT hits: %lld / %lld  (%.1f%%)", stats->ttHits, stats->ttProbes,
+             searchStatsPercent(stats->ttHits, stats->ttProbes));
+    snprintf(lines[5], sizeof(lines[5]), "Max depth: %d", stats->maxDepth);
+    snprintf(lines[6], sizeof(lines[6]), "Time: %.1f ms", stats->timeMs);
+
+    int width = 0;
+    for (int i = 0; i < SEARCH_STATS_LINES; i++) {
+        int w = MeasureText(lines[i], SEARCH_STATS_FONT_SIZE);
+        if (w > width) width = w;
+    }
+    int lineHeight = SEARCH_STATS_FONT_SIZE + 4;
+    DrawRectangle(x, y, width + 20, SEARCH_STATS_LINES * lineHeight + 16, Fade(background, 0.8f));
+    for (int i = 0; i < SEARCH_STATS_LINES; i++) {
+        DrawText(lines[i], x + 10, y + 8 + i * lineHeight, SEARCH_STATS_FONT_SIZE, textColor);
+    }
+}
+
+#endif // SEARCH_STATS_OVERLAY_H
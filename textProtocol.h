@@ -0,0 +1,135 @@
+// textProtocol.h - UCI-like stdin/stdout protocol shared by the headless front ends
+//
+// Each <game>Protocol.c describes its game with a TextProtocolGame and calls
+// runTextProtocol from main. One command per line:
+//
+//   uci                                  id name <game>, then uciok
+//   isready                              readyok
+//   ucinewgame                           Empty board, fresh search tables
+//   position startpos [moves m1 m2 ...]  Set up a position; the engine plays the side to move
+//   go [depth N] [nodes N] [movetime MS] Search (1000 ms if no limit is given). Prints one
+//                                        info line per finished iteration, then
+//                                        bestmove <move>, or bestmove (none) if the game is over
+//   setoption name Threads value N       Search threads, for engines that search in parallel
+//   d                                    Print the board
+//   quit
+//
+// Info lines read: info depth D score cp S nodes N nps N time MS pv m1 m2 ...
+// Scores are in the engine's own units, from the side to move's point of view.
+// go blocks until the search is done, so there is no stop command.
+
+#ifndef TEXT_PROTOCOL_H
+#define TEXT_PROTOCOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "engine/searchInfo.h"
+
+#define PROTOCOL_LINE_LENGTH 4096
+#define PROTOCOL_MAX_MOVES 128
+#define PROTOCOL_DEFAULT_MOVETIME_MS 1000
+
+typedef struct {
+    const char *name;
+    void (*newGame)(void);
+    bool (*setPosition)(char **moves, int count); // Replays the moves from the start; false if one is illegal
+    int (*search)(const SearchLimits *limits, SearchInfoCallback onInfo, void *ctx); // Best move, -1 if game over
+    void (*formatMove)(int move, char out[16]);
+    void (*printBoard)(void);
+    void (*setThreads)(int threads); // NULL if the engine searches on one thread
+} TextProtocolGame;
+
+static void printInfoLine(const SearchInfo *info, void *ctx) {
+    const TextProtocolGame *game = ctx;
+    long long nps = info->timeMs > 0 ? (long long)(info->nodes * 1000.0 / info->timeMs) : 0;
+    printf("info depth %d score cp %d nodes %lld nps %lld time %.0f pv",
+           info->depth, info->score, info->nodes, nps, info->timeMs);
+    for (int i = 0; i < info->pvLength; i++) {
+        char move[16];
+        game->formatMove(info->pv[i], move);
+        printf(" %s", move);
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+static void handleGo(const TextProtocolGame *game, char *args) {
+    SearchLimits limits = { 0 };
+    for (char *token = strtok(args, " \t"); token != NULL; token = strtok(NULL, " \t")) {
+        char *value = strtok(NULL, " \t");
+        if (value == NULL) break;
+        if (strcmp(token, "depth") == 0) limits.depth = atoi(value);
+        else if (strcmp(token, "nodes") == 0) limits.nodes = atoll(value);
+        else if (strcmp(token, "movetime") == 0) limits.timeMs = atof(value);
+    }
+    if (limits.depth <= 0 && limits.nodes <= 0 && limits.timeMs <= 0) limits.timeMs = PROTOCOL_DEFAULT_MOVETIME_MS;
+
+    int move = game->search(&limits, printInfoLine, (void *)game);
+    if (move == -1) {
+        printf("bestmove (none)\n");
+    } else {
+        char text[16];
+        game->formatMove(move, text);
+        printf("bestmove %s\n", text);
+    }
+    fflush(stdout);
+}
+
+static void handlePosition(const TextProtocolGame *game, char *args) {
+    char *moves[PROTOCOL_MAX_MOVES];
+    int count = 0;
+    char *token = strtok(args, " \t");
+    if (token == NULL || strcmp(token, "startpos") != 0) {
+        printf("info string expected: position startpos [moves ...]\n");
+        game->setPosition(moves, 0);
+        return;
+    }
+    token = strtok(NULL, " \t");
+    if (token != NULL && strcmp(token, "moves") == 0) {
+        while ((token = strtok(NULL, " \t")) != NULL && count < PROTOCOL_MAX_MOVES) moves[count++] = token;
+    }
+    if (!game->setPosition(moves, count)) {
+        printf("info string illegal move list, position reset to startpos\n");
+        game->setPosition(moves, 0);
+    }
+}
+
+// Reads commands until quit or end of input
+static void runTextProtocol(const TextProtocolGame *game) {
+    char line[PROTOCOL_LINE_LENGTH];
+    game->newGame();
+    game->setPosition(NULL, 0);
+
+    while (fgets(line, sizeof(line), stdin) != NULL) {
+        line[strcspn(line, "\r\n")] = '\0';
+        char *args = line + strcspn(line, " \t");
+        if (*args != '\0') *args++ = '\0';
+
+        if (strcmp(line, "uci") == 0) {
+            printf("id name %s\nuciok\n", game->name);
+        } else if (strcmp(line, "isready") == 0) {
+            printf("readyok\n");
+        } else if (strcmp(line, "ucinewgame") == 0) {
+            game->newGame();
+            game->setPosition(NULL, 0);
+        } else if (strcmp(line, "position") == 0) {
+            handlePosition(game, args);
+        } else if (strcmp(line, "go") == 0) {
+            handleGo(game, args);
+        } else if (strcmp(line, "setoption") == 0) {
+            int threads;
+            if (game->setThreads != NULL && sscanf(args, "name Threads value %d", &threads) == 1) game->setThreads(threads);
+        } else if (strcmp(line, "d") == 0) {
+            game->printBoard();
+        } else if (strcmp(line, "quit") == 0) {
+            break;
+        } else if (line[0] != '\0') {
+            printf("info string unknown command: %s\n", line);
+        }
+        fflush(stdout);
+    }
+}
+
+#endif // TEXT_PROTOCOL_H
@@ -1,22 +1,15 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <limits.h>
 #include <stdbool.h>
 #include <string.h>
 #include "include/raylib.h" // Include Raylib header
 #include "include/raymath.h" // Include Raymath header
-
-// Define constants (including those previously in the header)
-#define ROWS 4 // Changed for Sogo-like 4x4x4
-#define COLS 4 // Changed for Sogo-like 4x4x4
-#define PLAYER 1
-#define AI 2
-#define EMPTY 0
-#define HEIGHT 4 // Already 4, but confirming for 4x4x4
+#include "engine/threeDConnectFourEngine.h" // Board, rules and AI
+#include "engine/cpuCount.h" // Search threads per core
+#include "searchStatsOverlay.h" // F3 overlay and log of the AI's last search
 
 // Global variables
-int difficulty = 4; // Default AI depth (will be set by user)
-int board3D[HEIGHT][ROWS][COLS]; // Moved global board definition here
+Board3D board3D; // The game's position; the engine only ever searches copies of it
 Camera camera = { 0 }; // Raylib camera
 int currentPlayer = PLAYER;
 bool gameOver = false;
@@ -24,8 +17,16 @@ int winner = EMPTY; // 0: No winner, 1: Player, 2: AI, 3: Draw
 const float PIECE_RADIUS = 0.4f;
 const float SPACING = 1.0f; // Spacing between centers of pieces
 int previewH = -1, previewR = -1, previewC = -1; // For hover preview
-int winStartH = -1, winStartR = -1, winStartC = -1; // Winning line start
-int winDirH = 0, winDirR = 0, winDirC = 0;       // Winning line direction
+int winLine3D = -1; // Index into lines3D of the winning line, for rendering
+
+// Piece rendering: one sphere mesh on the GPU, drawn instanced once per color
+Mesh pieceMesh;
+Material pieceMaterial;   // Instancing shader; its diffuse color is set per draw
+Material previewMaterial; // Default shader, for the single hover preview
+Model winHaloModel;       // Low-poly sphere drawn as wires around the winning line
+Matrix pieceTransforms3D[3][NUM_CELLS3D]; // Per color, rebuilt only when the board changes
+int pieceCount3D[3];
+uint64_t pieceStones3D[3] = { ~0ULL, ~0ULL, ~0ULL }; // Stones the transforms were built from
 
 // Game States
 typedef enum {
@@ -36,30 +37,17 @@ typedef enum {
 
 GameState currentGameState = STATE_SELECT_DIFFICULTY;
 
-// Difficulty Levels
-#define DEPTH_EASY 2
-#define DEPTH_MEDIUM 4
-#define DEPTH_HARD 6
-
-// Forward declarations for 3D functions and others used before definition
-bool isFull3D();
+// Forward declarations for functions used before definition
 void clearInputBuffer();
 void playGame3D(); // Renamed from playGame
 void printBoard3D(); // Added forward declaration
-bool isValidMove3D(int r, int c); // Added forward declaration
-int makeMove3D(int r, int c, int piece); // Added forward declaration
-bool winningMove3D(int piece); // Added forward declaration
-void getBestMove3D(int *bestR, int *bestC); // Added forward declaration
-int minimax3D(int depth, int alpha, int beta, bool maximizing); // Added forward declaration
-int evaluateBoard3D(); // Added forward declaration
-void undoMove3D(int r, int c); // Added forward declaration
+void initPieceRendering();
+void freePieceRendering();
 void drawBoardRaylib(); // Forward declaration for Raylib drawing function
 void updateGameRaylib(); // Forward declaration for game logic update
 int findLandingHeight(int r, int c); // Helper to find where a piece would land
 
-// ----------------------- 3D CONNECT 4 SECTION -----------------------
-
-// int board3D[HEIGHT][ROWS][COLS]; // Moved higher up
+// ----------------------- CONSOLE HELPERS -----------------------
 
 void printBoard3D() {
     printf("\n3D CONNECT 4\n");
@@ -67,7 +55,7 @@ void printBoard3D() {
         printf("Level %d:\n", h);
         for (int r = 0; r < ROWS; r++) {
             for (int c = 0; c < COLS; c++) {
-                printf("| %d ", board3D[h][r][c] == EMPTY ? 0 : board3D[h][r][c]); // Use EMPTY
+                printf("| %d ", cellAt3D(&board3D, h, r, c));
             }
             printf("|\n");
         }
@@ -82,241 +70,6 @@ void printBoard3D() {
 
 }
 
-bool isValidMove3D(int r, int c) {
-    // Check bounds first
-    if (r < 0 || r >= ROWS || c < 0 || c >= COLS) {
-        return false;
-    }
-    // Check if the column is full (bottommost level has a piece) - Changed for bottom-up gravity
-    return board3D[HEIGHT - 1][r][c] == EMPTY; // Use EMPTY
-}
-
-
-int makeMove3D(int r, int c, int piece) {
-        // Find the lowest available height (h) in the selected (r, c) position - Changed for bottom-up gravity
-    for (int h = 0; h < HEIGHT; h++) { // Iterate from bottom (h=0) upwards
-        if (board3D[h][r][c] == EMPTY) { // Use EMPTY
-            board3D[h][r][c] = piece;
-            return h; // Return the height where the piece was placed
-        }
-    }
-    return -1; // Should not happen if isValidMove3D was checked
-}
-
-
-void undoMove3D(int r, int c) {
-    // Find the highest piece in the column (r, c) and remove it - Changed for bottom-up gravity
-    // This actually needs to find the highest piece to remove the last placed one.
-    for (int h = HEIGHT - 1; h >= 0; h--) { // Iterate from top down
-        if (board3D[h][r][c] != EMPTY) { // Use EMPTY
-            board3D[h][r][c] = EMPTY; // Use EMPTY
-            break; // Remove only the top-most piece in the stack
-        }
-    }
-}
-
-// Comprehensive check for 4-in-a-row in 3D
-bool winningMove3D(int piece) {
-    // Reset winning line info at the start of check
-    winStartH = -1; winStartR = -1; winStartC = -1;
-    winDirH = 0; winDirR = 0; winDirC = 0;
-
-    // Check all possible lines of 4 (horizontal, vertical, depth-wise, and all diagonals)
-    for (int h = 0; h < HEIGHT; ++h) {
-        for (int r = 0; r < ROWS; ++r) {
-            for (int c = 0; c < COLS; ++c) {
-                // Check lines starting from (h, r, c) in all 13 directions in 3D space
-                // (Only need to check directions where coordinates increase or stay same,
-                // as other directions are covered by starting from different points)
-
-                 // Simplified directions (check only positive/zero directions from each point)
-                 int simplified_directions[13][3] = {
-                    // Within a plane (h constant)
-                    {0, 0, 1},  // --> (Horizontal)
-                    {0, 1, 0},  // | (Vertical)
-                    {0, 1, 1},  // / (Diagonal up-right)
-                    {0, 1, -1}, // \\ (Diagonal up-left) - Need this one explicitly
-
-                    // Vertical columns
-                    {1, 0, 0},  // Upwards
-
-                    // Diagonals involving height change
-                    {1, 0, 1},  // Up-forward
-                    {1, 0, -1}, // Up-backward
-                    {1, 1, 0},  // Up-right (vertical plane)
-                    {1, -1, 0}, // Up-left (vertical plane)
-                    {1, 1, 1},  // 3D diagonal (all increasing)
-                    {1, 1, -1}, // 3D diagonal
-                    {1, -1, 1}, // 3D diagonal
-                    {1, -1, -1} // 3D diagonal
-                };
-
-
-                for (int i = 0; i < 13; ++i) {
-                    int dh = simplified_directions[i][0];
-                    int dr = simplified_directions[i][1];
-                    int dc = simplified_directions[i][2];
-
-                    // Check if the line fits within the board boundaries
-                    if (h + 3 * dh >= 0 && h + 3 * dh < HEIGHT &&
-                        r + 3 * dr >= 0 && r + 3 * dr < ROWS &&
-                        c + 3 * dc >= 0 && c + 3 * dc < COLS)
-                    {
-                        // Check if all 4 pieces match
-                        if (board3D[h][r][c] == piece &&
-                            board3D[h + dh][r + dr][c + dc] == piece &&
-                            board3D[h + 2 * dh][r + 2 * dr][c + 2 * dc] == piece &&
-                            board3D[h + 3 * dh][r + 3 * dr][c + 3 * dc] == piece)
-                        {
-                            // Store winning line info
-                            winStartH = h;
-                            winStartR = r;
-                            winStartC = c;
-                            winDirH = dh;
-                            winDirR = dr;
-                            winDirC = dc;
-                            return true;
-                        }
-                    }
-                }
-            }
-        }
-    }
-    return false; // No winning line found
-}
-
-
-// Basic evaluation for 3D
-int evaluateBoard3D() {
-     if (winningMove3D(AI)) return 100;
-     if (winningMove3D(PLAYER)) return -100;
-     return 0;
-}
-
-int minimax3D(int depth, int alpha, int beta, bool maximizing) {
-    if (winningMove3D(PLAYER)) return -100 - depth; // Prioritize faster wins/losses
-    if (winningMove3D(AI)) return 100 + depth;
-    if (isFull3D()) return 0;
-    if (depth == 0) return evaluateBoard3D();
-
-    if (maximizing) {
-        int maxEval = INT_MIN;
-        for (int r = 0; r < ROWS; r++) {
-            for (int c = 0; c < COLS; c++) {
-                if (isValidMove3D(r, c)) {
-                    int h = makeMove3D(r, c, AI); // Need height for potential undo optimization later if needed
-                    if (h != -1) { // Check if move was actually made
-                        int eval = minimax3D(depth - 1, alpha, beta, false);
-                        undoMove3D(r, c);
-                        maxEval = eval > maxEval ? eval : maxEval;
-                        alpha = alpha > eval ? alpha : eval;
-                        if (beta <= alpha)
-                            goto end_maximizing_loop; // Use goto for breaking nested loops
-                    }
-                }
-            }
-        }
-    end_maximizing_loop:;
-        return maxEval;
-    } else {
-        int minEval = INT_MAX;
-        for (int r = 0; r < ROWS; r++) {
-            for (int c = 0; c < COLS; c++) {
-                if (isValidMove3D(r, c)) {
-                     int h = makeMove3D(r, c, PLAYER);
-                     if (h != -1) {
-                        int eval = minimax3D(depth - 1, alpha, beta, true);
-                        undoMove3D(r, c);
-                        minEval = eval < minEval ? eval : minEval;
-                        beta = beta < eval ? beta : eval;
-                        if (beta <= alpha)
-                             goto end_minimizing_loop; // Use goto for breaking nested loops
-                    }
-                }
-            }
-        }
-     end_minimizing_loop:;
-        return minEval;
-    }
-}
-
-void getBestMove3D(int *bestR, int *bestC) {
-    int bestScore = INT_MIN;
-    *bestR = -1; // Initialize to invalid
-    *bestC = -1;
-
-    for (int r = 0; r < ROWS; r++) {
-        for (int c = 0; c < COLS; c++) {
-            if (isValidMove3D(r, c)) {
-                 // Check for immediate AI win
-                int h_win = makeMove3D(r, c, AI);
-                if (h_win != -1) {
-                    if (winningMove3D(AI)) {
-                        undoMove3D(r, c);
-                        *bestR = r;
-                        *bestC = c;
-                        return; // Found winning move
-                    }
-                    undoMove3D(r, c);
-                }
-
-                 // Check for immediate Player win to block
-                 int h_block = makeMove3D(r, c, PLAYER);
-                 if (h_block != -1) {
-                     if (winningMove3D(PLAYER)) {
-                         undoMove3D(r, c);
-                         *bestR = r; // Prioritize blocking
-                         *bestC = c;
-                         bestScore = INT_MAX - 1; // High score, but less than immediate win
-                         continue; // Check other moves in case AI can win immediately elsewhere
-                     }
-                     undoMove3D(r, c);
-                 }
-
-
-                // Run minimax if not blocking an immediate player win
-                 if (*bestR != r || *bestC != c || bestScore < INT_MAX -1) {
-                    int h_eval = makeMove3D(r, c, AI);
-                    if (h_eval != -1) {
-                        int score = minimax3D(difficulty, INT_MIN, INT_MAX, false);
-                        undoMove3D(r, c);
-                        if (score > bestScore) {
-                            bestScore = score;
-                            *bestR = r;
-                            *bestC = c;
-                        } else if (*bestR == -1) { // Ensure a move is chosen
-                             *bestR = r;
-                             *bestC = c;
-                        }
-                    }
-                 }
-            }
-        }
-    }
-     // If no move found (e.g., board full, though isFull3D should catch this)
-     // Or if all moves lead to loss and bestR/bestC remain -1
-    if (*bestR == -1 || *bestC == -1) {
-        for (int r = 0; r < ROWS; ++r) {
-            for (int c = 0; c < COLS; ++c) {
-                if (isValidMove3D(r, c)) {
-                    *bestR = r;
-                    *bestC = c;
-                    return;
-                }
-            }
-        }
-    }
-}
-
-
-bool isFull3D() {
-    for (int r = 0; r < ROWS; r++) // Check top level only is sufficient
-        for (int c = 0; c < COLS; c++)
-            if (board3D[0][r][c] == EMPTY)
-                return false;
-    return true;
-}
-
 // Function to clear the input buffer
 void clearInputBuffer() {
     int c;
@@ -326,12 +79,8 @@ void clearInputBuffer() {
 // Helper function to find the lowest empty slot (height) in a column
 int findLandingHeight(int r, int c) {
     if (r < 0 || r >= ROWS || c < 0 || c >= COLS) return -1; // Bounds check
-    for (int h = 0; h < HEIGHT; h++) { // Iterate bottom-up
-        if (board3D[h][r][c] == EMPTY) {
-            return h;
-        }
-    }
-    return -1; // Column is full
+    int h = board3D.height[r * COLS + c];
+    return (h < HEIGHT) ? h : -1; // -1 if the column is full
 }
 
 // ----------------------- RAYLIB VISUALIZATION & GAME LOOP -----------------------
@@ -349,6 +98,55 @@ Vector3 GetPiecePosition(int h, int r, int c) {
     return (Vector3){ x, y, z };
 }
 
+// Instancing shader for the pieces: per-instance transform, flat color like DrawSphere
+static const char *PIECE_VS =
+    "#version 330\n"
+    "in vec3 vertexPosition;\n"
+    "in mat4 instanceTransform;\n"
+    "uniform mat4 mvp;\n"
+    "void main() {\n"
+    "    gl_Position = mvp * instanceTransform * vec4(vertexPosition, 1.0);\n"
+    "}\n";
+static const char *PIECE_FS =
+    "#version 330\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    finalColor = colDiffuse;\n"
+    "}\n";
+
+// Uploads the piece geometry once. Needs the window (GL context) to exist.
+void initPieceRendering() {
+    pieceMesh = GenMeshSphere(PIECE_RADIUS, 16, 16); // Same tessellation as DrawSphere
+    pieceMaterial = LoadMaterialDefault();
+    pieceMaterial.shader = LoadShaderFromMemory(PIECE_VS, PIECE_FS);
+    pieceMaterial.shader.locs[SHADER_LOC_MATRIX_MVP] = GetShaderLocation(pieceMaterial.shader, "mvp");
+    pieceMaterial.shader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(pieceMaterial.shader, "instanceTransform");
+    previewMaterial = LoadMaterialDefault();
+    previewMaterial.maps[MATERIAL_MAP_DIFFUSE].color = Fade(RED, 0.5f);
+    winHaloModel = LoadModelFromMesh(GenMeshSphere(PIECE_RADIUS + 0.1f, 8, 8));
+}
+
+void freePieceRendering() {
+    UnloadMaterial(pieceMaterial); // Also unloads the instancing shader
+    UnloadMaterial(previewMaterial);
+    UnloadMesh(pieceMesh);
+    UnloadModel(winHaloModel);
+}
+
+// Rebuilds the per-color instance transforms if board3D has changed since the last call
+static void updatePieceTransforms() {
+    if (memcmp(pieceStones3D, board3D.stones, sizeof(pieceStones3D)) == 0) return;
+    memcpy(pieceStones3D, board3D.stones, sizeof(pieceStones3D));
+    pieceCount3D[PLAYER] = pieceCount3D[AI] = 0;
+    for (int cell = 0; cell < NUM_CELLS3D; cell++) {
+        int piece = cellAt3D(&board3D, cell / (ROWS * COLS), (cell / COLS) % ROWS, cell % COLS);
+        if (piece == EMPTY) continue;
+        Vector3 pos = GetPiecePosition(cell / (ROWS * COLS), (cell / COLS) % ROWS, cell % COLS);
+        pieceTransforms3D[piece][pieceCount3D[piece]++] = MatrixTranslate(pos.x, pos.y, pos.z);
+    }
+}
+
 // Raylib drawing function
 void drawBoardRaylib() {
     ClearBackground(RAYWHITE);
@@ -371,22 +169,12 @@ void drawBoardRaylib() {
         DrawCubeWiresV((Vector3){ boardCenter.x, boardCenter.y - SPACING/2.0f, boardCenter.z }, // Offset Y slightly to center wires around pieces
                        (Vector3){ boardWidth, boardHeight, boardDepth }, LIGHTGRAY);
 
-        // Draw the pieces (Loops updated for 4x4x4)
-        for (int h = 0; h < HEIGHT; h++) {
-            for (int r = 0; r < ROWS; r++) {
-                for (int c = 0; c < COLS; c++) {
-                    if (board3D[h][r][c] != EMPTY) {
-                        Vector3 pos = GetPiecePosition(h, r, c);
-                        Color color = (board3D[h][r][c] == PLAYER) ? RED : YELLOW;
-                        DrawSphere(pos, PIECE_RADIUS, color);
-                    }
-                    // Optional: Draw faint spheres for empty slots
-                    /* else {
-                        Vector3 pos = GetPiecePosition(h, r, c);
-                        DrawSphereWires(pos, PIECE_RADIUS * 0.8f, 6, 6, LIGHTGRAY);
-                    } */
-                }
-            }
+        // Draw the pieces: one instanced draw per color
+        updatePieceTransforms();
+        for (int piece = PLAYER; piece <= AI; piece++) {
+            if (pieceCount3D[piece] == 0) continue;
+            pieceMaterial.maps[MATERIAL_MAP_DIFFUSE].color = (piece == PLAYER) ? RED : YELLOW;
+            DrawMeshInstanced(pieceMesh, pieceMaterial, pieceTransforms3D[piece], pieceCount3D[piece]);
         }
 
         // Draw the base grid (4x4)
@@ -409,21 +197,22 @@ void drawBoardRaylib() {
         // Draw Preview Piece (if valid hover)
         if (previewH != -1) {
             Vector3 previewPos = GetPiecePosition(previewH, previewR, previewC);
-            DrawSphere(previewPos, PIECE_RADIUS, Fade(RED, 0.5f)); // Draw semi-transparent red sphere
+            DrawMesh(pieceMesh, previewMaterial, MatrixTranslate(previewPos.x, previewPos.y, previewPos.z)); // Semi-transparent red sphere
         }
 
         // Draw Winning Line (if game over and there's a winner)
         if (currentGameState == STATE_GAME_OVER && winner != EMPTY && winner != 3) { // 3 is Draw
-            if (winStartH != -1) { // Check if win info is valid
-                Vector3 startPos = GetPiecePosition(winStartH, winStartR, winStartC);
-                Vector3 endPos = GetPiecePosition(winStartH + 3 * winDirH,
-                                                winStartR + 3 * winDirR,
-                                                winStartC + 3 * winDirC);
-                DrawLine3D(startPos, endPos, BLACK); // Draw a thick black line
+            if (winLine3D != -1) { // Check if win info is valid
+                const unsigned char *cells = lines3D[winLine3D].cells;
+                Vector3 piecePos[4];
+                for (int i = 0; i < 4; i++) {
+                    int cell = cells[i];
+                    piecePos[i] = GetPiecePosition(cell / (ROWS * COLS), (cell / COLS) % ROWS, cell % COLS);
+                }
+                DrawLine3D(piecePos[0], piecePos[3], BLACK); // Draw a thick black line
                 // Optionally draw thicker line or highlight spheres
                 for (int i = 0; i < 4; i++) {
-                     Vector3 piecePos = GetPiecePosition(winStartH + i * winDirH, winStartR + i * winDirR, winStartC + i * winDirC);
-                     DrawSphereWires(piecePos, PIECE_RADIUS + 0.1f, 8, 8, BLACK);
+                     DrawModelWires(winHaloModel, piecePos[i], 1.0f, BLACK);
                  }
             }
         }
@@ -444,11 +233,12 @@ void drawBoardRaylib() {
             DrawText(turnText, 10, 40, 20, (currentPlayer == PLAYER) ? RED : ORANGE);
             // Optionally display current difficulty
             const char* diffText;
-            if (difficulty == DEPTH_EASY) diffText = "Easy";
-            else if (difficulty == DEPTH_MEDIUM) diffText = "Medium";
+            if (difficulty3D == DEPTH_EASY) diffText = "Easy";
+            else if (difficulty3D == DEPTH_MEDIUM) diffText = "Medium";
             else diffText = "Hard";
             DrawText(TextFormat("Difficulty: %s", diffText), GetScreenWidth() - 150, 10, 20, DARKGRAY);
         }
+        drawSearchStats(&searchStats3D, 10, 70, DARKGRAY, RAYWHITE); // getBestMove3D runs on this thread
     }
 }
 
@@ -462,13 +252,16 @@ void updateGameRaylib() {
     if (currentGameState == STATE_SELECT_DIFFICULTY) {
         // Handle Difficulty Selection Input
         if (IsKeyPressed(KEY_ONE)) {
-            difficulty = DEPTH_EASY;
+            difficulty3D = DEPTH_EASY;
+            moveTimeMs3D = TIME_EASY_MS;
             currentGameState = STATE_PLAYING;
         } else if (IsKeyPressed(KEY_TWO)) {
-            difficulty = DEPTH_MEDIUM;
+            difficulty3D = DEPTH_MEDIUM;
+            moveTimeMs3D = TIME_MEDIUM_MS;
             currentGameState = STATE_PLAYING;
         } else if (IsKeyPressed(KEY_THREE)) {
-            difficulty = DEPTH_HARD;
+            difficulty3D = DEPTH_HARD;
+            moveTimeMs3D = TIME_HARD_MS;
             currentGameState = STATE_PLAYING;
         }
     } else if (currentGameState == STATE_PLAYING) {
@@ -536,20 +329,21 @@ void updateGameRaylib() {
                 if (r < 0) r = 0; if (r >= ROWS) r = ROWS - 1;
 
                 // Update preview state if the move is valid
-                if (isValidMove3D(r, c)) {
+                if (isValidMove3D(&board3D, r, c)) {
                     previewH = findLandingHeight(r, c);
                     previewR = r;
                     previewC = c;
 
                     // Check for actual click to make the move
                     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-                        makeMove3D(r, c, PLAYER);
+                        makeMove3D(&board3D, r, c, PLAYER);
                         // Reset preview immediately after move
                         previewH = -1; previewR = -1; previewC = -1;
-                        if (winningMove3D(PLAYER)) {
+                        if (winningMove3D(&board3D, PLAYER)) {
                             currentGameState = STATE_GAME_OVER;
                             winner = PLAYER;
-                        } else if (isFull3D()) {
+                            winLine3D = findWinningLine3D(&board3D, PLAYER);
+                        } else if (isFull3D(&board3D)) {
                             currentGameState = STATE_GAME_OVER;
                             winner = 3; // Draw
                         } else {
@@ -568,16 +362,18 @@ void updateGameRaylib() {
         // AI's Turn Logic
         else if (currentPlayer == AI) {
             int ai_r, ai_c;
-            getBestMove3D(&ai_r, &ai_c);
+            getBestMove3D(&board3D, &ai_r, &ai_c);
 
             if (ai_r != -1 && ai_c != -1) { // Check if a valid move was found
-                makeMove3D(ai_r, ai_c, AI);
+                makeMove3D(&board3D, ai_r, ai_c, AI);
                  printf("AI moved at r=%d, c=%d\n", ai_r, ai_c); // Debug print
-                if (winningMove3D(AI)) {
+                logSearchStats("threeDConnectFour", &searchStats3D);
+                if (winningMove3D(&board3D, AI)) {
                     // gameOver = true; // Replaced by state change
                     currentGameState = STATE_GAME_OVER;
                     winner = AI;
-                } else if (isFull3D()) {
+                    winLine3D = findWinningLine3D(&board3D, AI);
+                } else if (isFull3D(&board3D)) {
                     // gameOver = true; // Replaced by state change
                     currentGameState = STATE_GAME_OVER;
                     winner = 3; // Use 3 for Draw consistently
@@ -585,7 +381,7 @@ void updateGameRaylib() {
                     currentPlayer = PLAYER;
                 }
             } else {
-                // Should not happen unless board is full and isFull3D() didn't catch it
+                // Should not happen unless board is full and isFull3D(&board3D) didn't catch it
                 printf("AI could not find a move!\n");
                 // gameOver = true; // Replaced by state change
                 currentGameState = STATE_GAME_OVER;
@@ -597,12 +393,12 @@ void updateGameRaylib() {
     } else { // STATE_GAME_OVER
         // Handle Restart Input
         if (IsKeyPressed(KEY_R)) {
-            memset(board3D, EMPTY, sizeof(board3D));
+            resetBoard3D(&board3D);
+            newGameTT3D(); // Keep the table, but let this game's entries replace the last one's
             currentPlayer = PLAYER;
             winner = EMPTY;
             // Reset winning line info
-            winStartH = -1; winStartR = -1; winStartC = -1;
-            winDirH = 0; winDirR = 0; winDirC = 0;
+            winLine3D = -1;
             currentGameState = STATE_SELECT_DIFFICULTY; // Go back to difficulty selection
         }
         // Allow camera movement even when game is over
@@ -651,6 +447,7 @@ int main() {
     const int screenHeight = 600; // Adjusted size
 
     InitWindow(screenWidth, screenHeight, "Sogo (4x4x4 Connect Four) - Raylib"); // Updated Title
+    initPieceRendering();
 
     // Define the camera to look into 3D space (Adjusted for 4x4x4)
     camera.position = (Vector3){ (COLS / 2.0f + 4)*SPACING, (HEIGHT + 1)*SPACING, (ROWS + 4)*SPACING }; // Pull back camera slightly more
@@ -659,8 +456,12 @@ int main() {
     camera.fovy = 45.0f;                                // Camera field-of-view Y
     camera.projection = CAMERA_PERSPECTIVE;             // Camera mode type
 
-    // Initialize 3D board (memset is fine for 4x4x4)
-    memset(board3D, EMPTY, sizeof(board3D));
+    // Initialize 3D board and the winning-line masks
+    initLines3D();
+    initZobrist3D();
+    initTT3D(TT_DEFAULT_SIZE_LOG2);
+    searchThreads3D = onlineCpuCount(MAX_SEARCH_THREADS3D); // One search thread per core
+    resetBoard3D(&board3D);
     currentPlayer = PLAYER; // Start with player
     gameOver = false;
     winner = EMPTY;
@@ -685,7 +486,9 @@ int main() {
     }
 
     // De-Initialization
+    freePieceRendering();
     CloseWindow();                // Close window and OpenGL context
+    freeTT3D();
 
     return 0;
 }
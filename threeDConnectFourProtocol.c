@@ -0,0 +1,70 @@
+// Headless Sogo (4x4x4 Connect Four): the engine behind the UCI-like text protocol
+// (see textProtocol.h)
+//
+// A move is the column as two digits, row then column, each 0-3: "03". The engine
+// always plays the side to move, as AI.
+
+#include <stdio.h>
+#include "engine/threeDConnectFourEngine.h"
+#include "textProtocol.h"
+
+Board3D board;
+
+static void newGame(void) {
+    newGameTT3D();
+}
+
+static bool setPosition(char **moves, int count) {
+    resetBoard3D(&board);
+    bool over = false;
+    for (int i = 0; i < count; i++) {
+        // Pieces alternate so that AI is the side to move after the last one
+        int piece = (count - i) % 2 == 0 ? AI : PLAYER;
+        const char *m = moves[i];
+        if (strlen(m) != 2 || over) return false;
+        int r = m[0] - '0', c = m[1] - '0';
+        if (!isValidMove3D(&board, r, c)) return false;
+        int h = makeMove3D(&board, r, c, piece);
+        over = lastMoveWins3D(&board, CELL3D(h, r, c), piece);
+    }
+    return true;
+}
+
+static int search(const SearchLimits *limits, SearchInfoCallback onInfo, void *ctx) {
+    if (winningMove3D(&board, AI) || winningMove3D(&board, PLAYER) || isFull3D(&board)) return -1;
+    int r, c;
+    getBestMove3DLimited(&board, limits, onInfo, ctx, &r, &c);
+    return r == -1 ? -1 : r * COLS + c;
+}
+
+static void formatMove(int move, char out[16]) {
+    snprintf(out, 16, "%d%d", move / COLS, move % COLS);
+}
+
+// One grid per level, bottom first; side to move as 'x', the other side as 'o'
+static void printBoard(void) {
+    for (int h = 0; h < HEIGHT; h++) {
+        printf("Level %d:\n", h);
+        for (int r = 0; r < ROWS; r++) {
+            for (int c = 0; c < COLS; c++) {
+                int piece = cellAt3D(&board, h, r, c);
+                printf("|%c", piece == AI ? 'x' : piece == PLAYER ? 'o' : ' ');
+            }
+            printf("|\n");
+        }
+    }
+}
+
+static void setThreads(int threads) {
+    searchThreads3D = threads < 1 ? 1 : threads > MAX_SEARCH_THREADS3D ? MAX_SEARCH_THREADS3D : threads;
+}
+
+int main(void) {
+    initLines3D();
+    initZobrist3D();
+    initTT3D(TT_DEFAULT_SIZE_LOG2);
+    TextProtocolGame game = { "threeDConnectFour", newGame, setPosition, search, formatMove, printBoard, setThreads };
+    runTextProtocol(&game);
+    freeTT3D();
+    return 0;
+}
@@ -3,21 +3,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
-#include <limits.h> // For INT_MIN, INT_MAX
-#include <ctype.h>  // For toupper
 #include <time.h>   // For srand
 #include <float.h>  // For FLT_MAX
 #include "include/raylib.h" // Include Raylib header
 #include "include/raymath.h" // Include Raymath header for 3D math
 #include "include/rlgl.h"    // Include Raylib GL header for low-level matrix transformations
+#include "engine/threeDTicTacToeEngine.h" // Board, rules and AI
+#include "searchStatsOverlay.h" // F3 overlay and log of the AI's last search
 //#include "include/camera.h"  // Explicitly include camera header
 
-#define SIZE 3
-#define EMPTY ' '
-#define WIN_SCORE 100
-#define LOSS_SCORE -100
-#define DRAW_SCORE 0
-
 // --- Raylib Specific Defines ---
 #define SCREEN_WIDTH 1060 // Increased width for better spacing
 #define SCREEN_HEIGHT 740 // Increased height slightly
@@ -40,15 +34,26 @@
 #define O_COLOR CLITERAL(Color){ 240, 90, 90, 255 }        // Bright red
 #define WIN_COLOR CLITERAL(Color){ 50, 200, 100, 255 }     // Bright green
 
+// --- Background Star Field ---
+#define STAR_COUNT 200        // Stars baked into the background mesh (at most 8192: mesh indices are 16-bit)
+#define STAR_FIELD_EXTENT 50  // Stars are placed in [-extent, extent] on each axis
+#define STAR_SIZE 0.05f       // Edge length of each star cube
+#if STAR_COUNT * 8 > 65536
+#error "STAR_COUNT too large for a mesh with 16-bit indices"
+#endif
+
 // Add to global variables
 float timeCounter = 0.0f; // For animations
 Model xModel, oModel;     // 3D models for markers
+Model starModel;          // All background stars in one mesh, drawn with a single call
+Shader markerShader;      // Instancing shader shared by the X and O models
 
-// Global variables for player symbols
-char USER_SYMBOL = 'X'; // Default, can be changed
-char AI_SYMBOL = 'O';
+// Static grid: every cell outline plus the outer box as line segments, built once
+#define GRID_LINE_VERTICES ((SIZE * SIZE * SIZE + 1) * 12 * 2)
+#define GRID_BOX_VERTICES (12 * 2) // The outer box's edges come first
+Vector3 gridLineVertices[GRID_LINE_VERTICES];
 
-// Variables to store winning line coordinates
+// Variables to store winning line coordinates (render state, set by UpdateWinningLine)
 Vector3 winningLineStart = {0}, winningLineMid = {0}, winningLineEnd = {0};
 bool drawWinningLine = false;
 
@@ -63,33 +68,135 @@ typedef enum {
 } GameScreen;
 
 // Function declarations (Forward Declarations)
-void InitializeBoard(char board[SIZE][SIZE][SIZE]);
-bool IsValidMove(char board[SIZE][SIZE][SIZE], int layer, int row, int col);
-bool IsBoardFull(char board[SIZE][SIZE][SIZE]);
-char CheckWinner(char board[SIZE][SIZE][SIZE]);
-int EvaluateBoard(char board[SIZE][SIZE][SIZE]);
-int Minimax(char board[SIZE][SIZE][SIZE], int depth, bool isMaximizing, int maxDepth);
-void GetAIMove(char board[SIZE][SIZE][SIZE], int ply, int *moveCount, int *bestL, int *bestR, int *bestC); // Modified to return move
+void UpdateWinningLine(char board[SIZE][SIZE][SIZE]);
 void DrawBoard3D(char board[SIZE][SIZE][SIZE], Camera camera, int hoverL, int hoverR, int hoverC); // Added hover parameters
 void DrawUI(GameScreen currentScreen, char winner, Font font, int difficulty, char selectedSymbol);
 Vector3 GetCellCenter(int layer, int row, int col); // Helper to get 3D center of a cell
+Mesh GenStarFieldMesh(int starCount);
+void BuildGridLines(void);
+
+// Instancing shader for the markers: per-instance transform, flat color with simple diffuse shading
+static const char *MARKER_VS =
+    "#version 330\n"
+    "in vec3 vertexPosition;\n"
+    "in vec3 vertexNormal;\n"
+    "in mat4 instanceTransform;\n"
+    "uniform mat4 mvp;\n"
+    "out vec3 fragNormal;\n"
+    "void main() {\n"
+    "    fragNormal = mat3(instanceTransform) * vertexNormal;\n"
+    "    gl_Position = mvp * instanceTransform * vec4(vertexPosition, 1.0);\n"
+    "}\n";
+static const char *MARKER_FS =
+    "#version 330\n"
+    "in vec3 fragNormal;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    float light = 0.55 + 0.45 * abs(dot(normalize(fragNormal), normalize(vec3(0.4, 1.0, 0.6))));\n"
+    "    finalColor = vec4(colDiffuse.rgb * light, colDiffuse.a);\n"
+    "}\n";
 
 // Load 3D models for X and O
 void LoadModels() {
-    // X model (two intersecting cylinders)
-    Mesh xMesh = GenMeshCylinder(0.1f, MARKER_CUBE_SIZE*1.4f, 8);
+    // X model: one bar, centered and tilted 45 degrees; an X is this bar drawn twice
+    float barLength = MARKER_CUBE_SIZE * 1.4f;
+    Mesh xMesh = GenMeshCylinder(0.1f, barLength, 8);
     xModel = LoadModelFromMesh(xMesh);
-    xModel.transform = MatrixRotateZ(45*DEG2RAD);
+    xModel.transform = MatrixMultiply(MatrixTranslate(0.0f, -barLength / 2.0f, 0.0f), MatrixRotateZ(45*DEG2RAD));
     
-    // O model (torus)
-    Mesh oMesh = GenMeshTorus(MARKER_RADIUS*0.7f, MARKER_RADIUS*0.3f, 16, 16);
+    // O model (torus). GenMeshTorus takes the tube radius relative to a unit ring and
+    // scales the whole shape by size/2, so this gives an outer radius of MARKER_RADIUS.
+    Mesh oMesh = GenMeshTorus(0.35f, MARKER_RADIUS * 2.0f / 1.35f, 24, 12);
     oModel = LoadModelFromMesh(oMesh);
+
+    // Both models are drawn with DrawMeshInstanced, one call per symbol
+    markerShader = LoadShaderFromMemory(MARKER_VS, MARKER_FS);
+    markerShader.locs[SHADER_LOC_MATRIX_MVP] = GetShaderLocation(markerShader, "mvp");
+    markerShader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(markerShader, "instanceTransform");
+    xModel.materials[0].shader = markerShader;
+    oModel.materials[0].shader = markerShader;
+
+    // Background stars
+    starModel = LoadModelFromMesh(GenStarFieldMesh(STAR_COUNT));
+
+    BuildGridLines();
+}
+
+// Corners of a star cube as (x, y, z) bits 0..2, wound counter-clockwise seen from outside
+static const unsigned short STAR_CUBE_INDICES[36] = {
+    0, 4, 6, 0, 6, 2,  1, 3, 7, 1, 7, 5,  0, 1, 5, 0, 5, 4,
+    2, 6, 7, 2, 7, 3,  0, 2, 3, 0, 3, 1,  4, 5, 7, 4, 7, 6
+};
+
+// Bakes starCount small cubes at random positions into one static mesh. The field is
+// generated once, so it no longer costs a draw call and three RNG calls per star per frame.
+Mesh GenStarFieldMesh(int starCount) {
+    Mesh mesh = { 0 };
+    mesh.vertexCount = starCount * 8;
+    mesh.triangleCount = starCount * 12;
+    mesh.vertices = MemAlloc(mesh.vertexCount * 3 * sizeof(float));
+    mesh.indices = MemAlloc(mesh.triangleCount * 3 * sizeof(unsigned short));
+
+    for (int i = 0; i < starCount; i++) {
+        Vector3 center = {
+            (float)GetRandomValue(-STAR_FIELD_EXTENT, STAR_FIELD_EXTENT),
+            (float)GetRandomValue(-STAR_FIELD_EXTENT, STAR_FIELD_EXTENT),
+            (float)GetRandomValue(-STAR_FIELD_EXTENT, STAR_FIELD_EXTENT)
+        };
+        float *v = &mesh.vertices[i * 8 * 3];
+        for (int corner = 0; corner < 8; corner++) {
+            v[corner * 3 + 0] = center.x + ((corner & 1) ? 0.5f : -0.5f) * STAR_SIZE;
+            v[corner * 3 + 1] = center.y + ((corner & 2) ? 0.5f : -0.5f) * STAR_SIZE;
+            v[corner * 3 + 2] = center.z + ((corner & 4) ? 0.5f : -0.5f) * STAR_SIZE;
+        }
+        for (int k = 0; k < 36; k++) {
+            mesh.indices[i * 36 + k] = (unsigned short)(i * 8 + STAR_CUBE_INDICES[k]);
+        }
+    }
+
+    UploadMesh(&mesh, false);
+    return mesh;
+}
+
+// Appends the 12 edges of an axis-aligned box to gridLineVertices, starting at *count
+static void AddBoxEdges(Vector3 minCorner, Vector3 maxCorner, int *count) {
+    for (int axis = 0; axis < 3; axis++) {
+        // The four edges parallel to this axis, one per combination of the other two bounds
+        for (int k = 0; k < 4; k++) {
+            Vector3 a = minCorner, b = maxCorner;
+            float *pa = &a.x, *pb = &b.x;
+            int u = (axis + 1) % 3, v = (axis + 2) % 3;
+            pa[u] = pb[u] = (k & 1) ? (&maxCorner.x)[u] : (&minCorner.x)[u];
+            pa[v] = pb[v] = (k & 2) ? (&maxCorner.x)[v] : (&minCorner.x)[v];
+            gridLineVertices[(*count)++] = a;
+            gridLineVertices[(*count)++] = b;
+        }
+    }
+}
+
+// Builds the static grid once: the outer box first, then every cell outline
+void BuildGridLines(void) {
+    int count = 0;
+    float halfGrid = (SIZE * CELL_SIZE_3D + (SIZE - 1) * GRID_SPACING_3D) / 2.0f;
+    AddBoxEdges((Vector3){ -halfGrid, -halfGrid, -halfGrid }, (Vector3){ halfGrid, halfGrid, halfGrid }, &count);
+    for (int l = 0; l < SIZE; l++) {
+        for (int r = 0; r < SIZE; r++) {
+            for (int c = 0; c < SIZE; c++) {
+                Vector3 center = GetCellCenter(l, r, c);
+                Vector3 half = { CELL_SIZE_3D / 2.0f, CELL_SIZE_3D / 2.0f, CELL_SIZE_3D / 2.0f };
+                AddBoxEdges(Vector3Subtract(center, half), Vector3Add(center, half), &count);
+            }
+        }
+    }
 }
 
 // Unload models
 void UnloadModels() {
     UnloadModel(xModel);
     UnloadModel(oModel);
+    UnloadModel(starModel);
+    UnloadShader(markerShader); // Models leave shared shaders to the caller
 }
 
 // --- Main Game Function ---
@@ -101,9 +208,10 @@ int main(void) {
     srand(time(NULL)); // Seed random number generator for AI move randomization
 
     char board[SIZE][SIZE][SIZE];
-    InitializeBoard(board);
+    InitializeBoard3D(board);
 
     int moveCount = 0;
+    SearchStats aiStats = { 0 }; // The AI's last search, for the overlay
     char winner = EMPTY;
     bool userStarts = true;
     int difficulty = 2;
@@ -138,6 +246,7 @@ int main(void) {
     while (!WindowShouldClose()) {
         // Update
         //----------------------------------------------------------------------------------
+        timeCounter += GetFrameTime();
 
         // --- Remove Debug Mouse Buttons ---
         // if (IsMouseButtonDown(MOUSE_BUTTON_LEFT)) printf("Debug: Left Mouse Down\n");
@@ -269,12 +378,13 @@ int main(void) {
                         if (IsValidMove(board, hoverLayer, hoverRow, hoverCol)) {
                             board[hoverLayer][hoverRow][hoverCol] = USER_SYMBOL;
                             moveCount++;
-                            winner = CheckWinner(board);
+                            winner = CheckWinner3D(board);
                             // DEBUG: Print winning line start X if win detected
                             //if (drawWinningLine) {
                             //    printf("DEBUG: Win detected! winningLineStart.x = %f\n", winningLineStart.x);
                             //}
                             if (winner != EMPTY || IsBoardFull(board)) {
+                                UpdateWinningLine(board);
                                 currentScreen = GAME_OVER;
                             } else {
                                 currentScreen = AI_TURN;
@@ -285,14 +395,36 @@ int main(void) {
                 break;
 
             case AI_TURN:
-                currentScreen = AI_THINKING;
+                // The search runs on a worker thread with its own copy of the board;
+                // AI_THINKING polls it so the 3D view keeps animating meanwhile.
                 aiBestL = -1; aiBestR = -1; aiBestC = -1;
-                GetAIMove(board, difficulty, &moveCount, &aiBestL, &aiBestR, &aiBestC);
+                if (StartAIWorker(board, difficulty)) {
+                    currentScreen = AI_THINKING;
+                    break;
+                }
+                // No thread available: search synchronously as a fallback
+                GetAIMove(board, difficulty, &aiStats, &aiBestL, &aiBestR, &aiBestC);
+                currentScreen = AI_THINKING;
+                // fall through
+
+             case AI_THINKING:
+                if (IsKeyPressed(KEY_R)) { // Restart: abandon the search and its move
+                    StopAIWorker();
+                    InitializeBoard3D(board);
+                    moveCount = 0;
+                    winner = EMPTY;
+                    drawWinningLine = false;
+                    currentScreen = SELECT_SYMBOL;
+                    break;
+                }
+                if (IsAIWorkerRunning() && !PollAIWorker(&aiBestL, &aiBestR, &aiBestC, &aiStats)) break; // Still thinking
                 if (aiBestL != -1 && IsValidMove(board, aiBestL, aiBestR, aiBestC)) {
                      board[aiBestL][aiBestR][aiBestC] = AI_SYMBOL;
                      moveCount++;
-                     winner = CheckWinner(board);
+                     logSearchStats("threeDTicTacToe", &aiStats);
+                     winner = CheckWinner3D(board);
                      if (winner != EMPTY || IsBoardFull(board)) {
+                         UpdateWinningLine(board);
                          currentScreen = GAME_OVER;
                      } else {
                          currentScreen = PLAYER_TURN;
@@ -303,13 +435,9 @@ int main(void) {
                 }
                 break;
 
-             case AI_THINKING:
-                 // Brief state, transitions immediately after GetAIMove
-                 break;
-
             case GAME_OVER:
                 if (IsKeyPressed(KEY_R)) {
-                    InitializeBoard(board); 
+                    InitializeBoard3D(board); 
                     moveCount = 0;
                     winner = EMPTY;
                     drawWinningLine = false;
@@ -332,11 +460,13 @@ int main(void) {
 
         // Draw 2D UI elements on top
         DrawUI(currentScreen, winner, font, difficulty, USER_SYMBOL);
+        drawSearchStats(&aiStats, 10, 120, WHITE, BLACK); // Below the UI panel
         DrawFPS(SCREEN_WIDTH - 90, 10); // Show FPS
 
         EndDrawing();
         //----------------------------------------------------------------------------------
     }
+    StopAIWorker();
     UnloadModels();
     // De-Initialization
     //--------------------------------------------------------------------------------------
@@ -348,78 +478,6 @@ int main(void) {
 
 // --- Helper Functions ---
 
-// Scores a single line based on player symbols and empty spaces
-int ScoreLine(char c1, char c2, char c3, char player) {
-    int playerCount = 0;
-    int emptyCount = 0;
-
-    if (c1 == player) playerCount++; else if (c1 == EMPTY) emptyCount++;
-    if (c2 == player) playerCount++; else if (c2 == EMPTY) emptyCount++;
-    if (c3 == player) playerCount++; else if (c3 == EMPTY) emptyCount++;
-
-    // Check if the opponent has any symbols in the line
-    char opponent = (player == USER_SYMBOL) ? AI_SYMBOL : USER_SYMBOL;
-    if ((c1 == opponent) || (c2 == opponent) || (c3 == opponent)) {
-        return 0; // Line is blocked by opponent, no potential value for 'player'
-    }
-
-
-    if (playerCount == 2 && emptyCount == 1) {
-        return 10; // High value for imminent win/block opportunity
-    } else if (playerCount == 1 && emptyCount == 2) {
-        return 1;  // Low value for starting a line
-    } else {
-        return 0;  // No potential for this player in this line
-    }
-}
-
-// Calculates the total heuristic score for a player on the board
-int CalculateTotalHeuristic(char board[SIZE][SIZE][SIZE], char player) {
-    int totalScore = 0;
-
-    // Check lines within each XY plane (fixed layer i)
-    for (int i = 0; i < SIZE; i++) {
-        // Rows
-        totalScore += ScoreLine(board[i][0][0], board[i][0][1], board[i][0][2], player);
-        totalScore += ScoreLine(board[i][1][0], board[i][1][1], board[i][1][2], player);
-        totalScore += ScoreLine(board[i][2][0], board[i][2][1], board[i][2][2], player);
-        // Columns
-        totalScore += ScoreLine(board[i][0][0], board[i][1][0], board[i][2][0], player);
-        totalScore += ScoreLine(board[i][0][1], board[i][1][1], board[i][2][1], player);
-        totalScore += ScoreLine(board[i][0][2], board[i][1][2], board[i][2][2], player);
-        // Diagonals
-        totalScore += ScoreLine(board[i][0][0], board[i][1][1], board[i][2][2], player);
-        totalScore += ScoreLine(board[i][0][2], board[i][1][1], board[i][2][0], player);
-    }
-
-    // Check lines within each XZ plane (fixed row j) - Diagonals only
-    for (int j = 0; j < SIZE; j++) {
-        totalScore += ScoreLine(board[0][j][0], board[1][j][1], board[2][j][2], player);
-        totalScore += ScoreLine(board[0][j][2], board[1][j][1], board[2][j][0], player);
-    }
-
-    // Check lines within each YZ plane (fixed column k) - Diagonals only
-     for (int k = 0; k < SIZE; k++) {
-        totalScore += ScoreLine(board[0][0][k], board[1][1][k], board[2][2][k], player);
-        totalScore += ScoreLine(board[0][2][k], board[1][1][k], board[2][0][k], player);
-    }
-
-    // Check columns across layers (vertical lines)
-    for (int j = 0; j < SIZE; j++) {
-        for (int k = 0; k < SIZE; k++) {
-            totalScore += ScoreLine(board[0][j][k], board[1][j][k], board[2][j][k], player);
-        }
-    }
-
-    // Check 3D diagonals
-    totalScore += ScoreLine(board[0][0][0], board[1][1][1], board[2][2][2], player);
-    totalScore += ScoreLine(board[0][0][2], board[1][1][1], board[2][2][0], player);
-    totalScore += ScoreLine(board[0][2][0], board[1][1][1], board[2][0][2], player);
-    totalScore += ScoreLine(board[0][2][2], board[1][1][1], board[2][0][0], player);
-
-    return totalScore;
-}
-
 // Calculate the 3D center position of a cell
 Vector3 GetCellCenter(int layer, int row, int col) {
     float totalSize = SIZE * CELL_SIZE_3D + (SIZE - 1) * GRID_SPACING_3D;
@@ -432,197 +490,19 @@ Vector3 GetCellCenter(int layer, int row, int col) {
     return (Vector3){ x, y, z };
 }
 
-void InitializeBoard(char board[SIZE][SIZE][SIZE]) {
-    for (int i = 0; i < SIZE; i++) {
-        for (int j = 0; j < SIZE; j++) {
-            for (int k = 0; k < SIZE; k++) {
-                board[i][j][k] = EMPTY;
-            }
-        }
-    }
-}
-
-bool IsValidMove(char board[SIZE][SIZE][SIZE], int layer, int row, int col) {
-    return layer >= 0 && layer < SIZE &&
-           row >= 0 && row < SIZE &&
-           col >= 0 && col < SIZE &&
-           board[layer][row][col] == EMPTY;
-}
-
-bool IsBoardFull(char board[SIZE][SIZE][SIZE]) {
-    for (int i = 0; i < SIZE; i++) {
-        for (int j = 0; j < SIZE; j++) {
-            for (int k = 0; k < SIZE; k++) {
-                if (board[i][j][k] == EMPTY) {
-                    return false;
-                }
-            }
-        }
-    }
-    return true;
-}
-
-char CheckWinner(char board[SIZE][SIZE][SIZE]) {
-    char players[] = {USER_SYMBOL, AI_SYMBOL};
-    drawWinningLine = false; // Reset before checking
-
-    for (int p = 0; p < 2; p++) {
-        char player = players[p];
-
-        // Check lines within each XY plane (fixed layer i)
-        for (int i = 0; i < SIZE; i++) { 
-            // Check Rows (across columns k)
-            if (board[i][0][0] == player && board[i][0][1] == player && board[i][0][2] == player) { winningLineStart=GetCellCenter(i,0,0); winningLineMid=GetCellCenter(i,0,1); winningLineEnd=GetCellCenter(i,0,2); drawWinningLine=true; return player; }
-            if (board[i][1][0] == player && board[i][1][1] == player && board[i][1][2] == player) { winningLineStart=GetCellCenter(i,1,0); winningLineMid=GetCellCenter(i,1,1); winningLineEnd=GetCellCenter(i,1,2); drawWinningLine=true; return player; }
-            if (board[i][2][0] == player && board[i][2][1] == player && board[i][2][2] == player) { winningLineStart=GetCellCenter(i,2,0); winningLineMid=GetCellCenter(i,2,1); winningLineEnd=GetCellCenter(i,2,2); drawWinningLine=true; return player; }
-            // Check Columns (across rows j)
-            if (board[i][0][0] == player && board[i][1][0] == player && board[i][2][0] == player) { winningLineStart=GetCellCenter(i,0,0); winningLineMid=GetCellCenter(i,1,0); winningLineEnd=GetCellCenter(i,2,0); drawWinningLine=true; return player; }
-            if (board[i][0][1] == player && board[i][1][1] == player && board[i][2][1] == player) { winningLineStart=GetCellCenter(i,0,1); winningLineMid=GetCellCenter(i,1,1); winningLineEnd=GetCellCenter(i,2,1); drawWinningLine=true; return player; }
-            if (board[i][0][2] == player && board[i][1][2] == player && board[i][2][2] == player) { winningLineStart=GetCellCenter(i,0,2); winningLineMid=GetCellCenter(i,1,2); winningLineEnd=GetCellCenter(i,2,2); drawWinningLine=true; return player; }
-            // Check Diagonals
-            if (board[i][0][0] == player && board[i][1][1] == player && board[i][2][2] == player) { winningLineStart=GetCellCenter(i,0,0); winningLineMid=GetCellCenter(i,1,1); winningLineEnd=GetCellCenter(i,2,2); drawWinningLine=true; return player; } // Main diag
-            if (board[i][0][2] == player && board[i][1][1] == player && board[i][2][0] == player) { winningLineStart=GetCellCenter(i,0,2); winningLineMid=GetCellCenter(i,1,1); winningLineEnd=GetCellCenter(i,2,0); drawWinningLine=true; return player; } // Anti diag
-        }
-
-        // Check lines within each XZ plane (fixed row j)
-        for (int j = 0; j < SIZE; j++) {
-             // Check Diagonals
-             if (board[0][j][0] == player && board[1][j][1] == player && board[2][j][2] == player) { winningLineStart=GetCellCenter(0,j,0); winningLineMid=GetCellCenter(1,j,1); winningLineEnd=GetCellCenter(2,j,2); drawWinningLine=true; return player; } // Main diag
-             if (board[0][j][2] == player && board[1][j][1] == player && board[2][j][0] == player) { winningLineStart=GetCellCenter(0,j,2); winningLineMid=GetCellCenter(1,j,1); winningLineEnd=GetCellCenter(2,j,0); drawWinningLine=true; return player; } // Anti diag
-        }
-
-        // Check lines within each YZ plane (fixed column k)
-        for (int k = 0; k < SIZE; k++) {
-             // Check Diagonals
-             if (board[0][0][k] == player && board[1][1][k] == player && board[2][2][k] == player) { winningLineStart=GetCellCenter(0,0,k); winningLineMid=GetCellCenter(1,1,k); winningLineEnd=GetCellCenter(2,2,k); drawWinningLine=true; return player; } // Main diag
-             if (board[0][2][k] == player && board[1][1][k] == player && board[2][0][k] == player) { winningLineStart=GetCellCenter(0,2,k); winningLineMid=GetCellCenter(1,1,k); winningLineEnd=GetCellCenter(2,0,k); drawWinningLine=true; return player; } // Anti diag
-        }
-
-
-        // Check columns across layers (vertical lines) - Some redundancy, but clear
-        for (int j = 0; j < SIZE; j++) { // Row
-            for (int k = 0; k < SIZE; k++) { // Column
-                if (board[0][j][k] == player && board[1][j][k] == player && board[2][j][k] == player) {
-                    winningLineStart = GetCellCenter(0, j, k);
-                    winningLineMid = GetCellCenter(1, j, k);
-                    winningLineEnd = GetCellCenter(2, j, k);
-                    drawWinningLine = true;
-                    return player;
-                }
-            }
-        }
-
-        // Check 3D diagonals (4 main space diagonals)
-        if (board[0][0][0] == player && board[1][1][1] == player && board[2][2][2] == player) { winningLineStart=GetCellCenter(0,0,0); winningLineMid=GetCellCenter(1,1,1); winningLineEnd=GetCellCenter(2,2,2); drawWinningLine=true; return player; }
-        if (board[0][0][2] == player && board[1][1][1] == player && board[2][2][0] == player) { winningLineStart=GetCellCenter(0,0,2); winningLineMid=GetCellCenter(1,1,1); winningLineEnd=GetCellCenter(2,2,0); drawWinningLine=true; return player; }
-        if (board[0][2][0] == player && board[1][1][1] == player && board[2][0][2] == player) { winningLineStart=GetCellCenter(0,2,0); winningLineMid=GetCellCenter(1,1,1); winningLineEnd=GetCellCenter(2,0,2); drawWinningLine=true; return player; }
-        if (board[0][2][2] == player && board[1][1][1] == player && board[2][0][0] == player) { winningLineStart=GetCellCenter(0,2,2); winningLineMid=GetCellCenter(1,1,1); winningLineEnd=GetCellCenter(2,0,0); drawWinningLine=true; return player; }
-
-    } // End player loop p
-
-    return EMPTY; // No winner found
-}
-
-// --- AI Logic ---
-
-// Evaluate the board state for the Minimax algorithm
-int EvaluateBoard(char board[SIZE][SIZE][SIZE]) {
-    char winner = CheckWinner(board); // Use the comprehensive CheckWinner
-
-    if (winner == AI_SYMBOL) {
-        return WIN_SCORE; // AI wins immediately
-    } else if (winner == USER_SYMBOL) {
-        return LOSS_SCORE; // User wins immediately
-    } else {
-        // No immediate winner, evaluate based on the new heuristic
-        int aiScore = CalculateTotalHeuristic(board, AI_SYMBOL);
-        int userScore = CalculateTotalHeuristic(board, USER_SYMBOL);
-
-        // Return the difference in heuristic scores
-        return aiScore - userScore;
-    }
-}
-
-// Minimax algorithm
-int Minimax(char board[SIZE][SIZE][SIZE], int depth, bool isMaximizing, int maxDepth) {
-    // Check for immediate win/loss/draw first
-    char immediateWinner = CheckWinner(board); 
-    if (immediateWinner == AI_SYMBOL) return WIN_SCORE - depth; // Prioritize faster wins
-    if (immediateWinner == USER_SYMBOL) return LOSS_SCORE + depth; // Prioritize blocking faster losses
-    if (IsBoardFull(board)) return DRAW_SCORE; // Draw
-    if (depth == maxDepth) return EvaluateBoard(board); // Evaluate heuristic at max depth
-
-    if (isMaximizing) { // AI's turn (Maximizer)
-        int bestScore = INT_MIN;
-        for (int i = 0; i < SIZE; i++) {
-            for (int j = 0; j < SIZE; j++) {
-                for (int k = 0; k < SIZE; k++) {
-                    if (board[i][j][k] == EMPTY) {
-                        board[i][j][k] = AI_SYMBOL;
-                        int score = Minimax(board, depth + 1, false, maxDepth);
-                        board[i][j][k] = EMPTY; // Undo move
-                        bestScore = (score > bestScore) ? score : bestScore;
-                         // Alpha-beta pruning could be added here
-                    }
-                }
-            }
-        }
-        return bestScore;
-    } else { // User's turn (Minimizer)
-        int bestScore = INT_MAX;
-        for (int i = 0; i < SIZE; i++) {
-            for (int j = 0; j < SIZE; j++) {
-                for (int k = 0; k < SIZE; k++) {
-                    if (board[i][j][k] == EMPTY) {
-                        board[i][j][k] = USER_SYMBOL;
-                        int score = Minimax(board, depth + 1, true, maxDepth);
-                        board[i][j][k] = EMPTY; // Undo move
-                        bestScore = (score < bestScore) ? score : bestScore;
-                         // Alpha-beta pruning could be added here
-                    }
-                }
-            }
-        }
-        return bestScore;
-    }
-}
-
-void GetAIMove(char board[SIZE][SIZE][SIZE], int ply, int *moveCount, int *bestL, int *bestR, int *bestC) {
-    int bestScore = INT_MIN;
-    *bestL = -1; *bestR = -1; *bestC = -1;
-    typedef struct { int l, r, c; } Move;
-    Move bestMoves[SIZE*SIZE*SIZE];
-    int numBestMoves = 0;
-
-    for (int i = 0; i < SIZE; i++) {
-        for (int j = 0; j < SIZE; j++) {
-            for (int k = 0; k < SIZE; k++) {
-                if (board[i][j][k] == EMPTY) {
-                    board[i][j][k] = AI_SYMBOL;
-                    int moveScore = Minimax(board, 0, false, ply);
-                    board[i][j][k] = EMPTY;
-
-                    if (moveScore > bestScore) {
-                        bestScore = moveScore;
-                        numBestMoves = 0;
-                        bestMoves[numBestMoves++] = (Move){i, j, k};
-                    } else if (moveScore == bestScore) {
-                         bestMoves[numBestMoves++] = (Move){i, j, k};
-                    }
-                }
-            }
-        }
-    }
+// Computes the render geometry of the winning line. Called once when the game ends.
+void UpdateWinningLine(char board[SIZE][SIZE][SIZE]) {
+    int line = FindWinningLine(board);
+    drawWinningLine = (line != -1);
+    if (!drawWinningLine) return;
 
-    if (numBestMoves > 0) {
-        int randomIndex = rand() % numBestMoves;
-        *bestL = bestMoves[randomIndex].l;
-        *bestR = bestMoves[randomIndex].r;
-        *bestC = bestMoves[randomIndex].c;
+    Vector3 *points[3] = { &winningLineStart, &winningLineMid, &winningLineEnd };
+    for (int i = 0; i < 3; i++) {
+        int cell = WIN_LINES[line][i];
+        *points[i] = GetCellCenter(cell / 9, (cell / 3) % 3, cell % 3);
     }
 }
 
-
 // --- Raylib Drawing Functions ---
 
 /*void DrawBoard3D(char board[SIZE][SIZE][SIZE], Camera camera, int hoverL, int hoverR, int hoverC) {
@@ -702,77 +582,55 @@ void DrawBoard3D(char board[SIZE][SIZE][SIZE], Camera camera, int hoverL, int ho
 
     ClearBackground(BACKGROUND_COLOR);
 
-    // Draw stars in background
-    for(int i = 0; i < 200; i++) {
-        DrawCubeV((Vector3){
-            (float)GetRandomValue(-50, 50),
-            (float)GetRandomValue(-50, 50),
-            (float)GetRandomValue(-50, 50)
-        }, (Vector3){0.05f, 0.05f, 0.05f}, WHITE);
-    }
-
-    // Draw glowing grid base
-    float gridSize = SIZE * (CELL_SIZE_3D + GRID_SPACING_3D);
-    //DrawGrid((int)gridSize, 1.0f);
-
-    // Calculate grid boundaries for drawing outer lines
-    float totalGridDim = SIZE * CELL_SIZE_3D + (SIZE - 1) * GRID_SPACING_3D;
-    float halfGrid = totalGridDim / 2.0f;
-    Vector3 minBound = { -halfGrid, -halfGrid, -halfGrid };
-    Vector3 maxBound = { halfGrid, halfGrid, halfGrid };
+    // Draw stars in background (baked once in LoadModels)
+    DrawModel(starModel, (Vector3){ 0.0f, 0.0f, 0.0f }, 1.0f, WHITE);
 
-    // Draw the outer bounding box of the 3x3x3 grid
-    DrawBoundingBox((BoundingBox){minBound, maxBound}, DARKGRAY);
+    // Draw the static grid (built once in LoadModels) as real lines in one batch:
+    // outer box in dark gray, then the cell outlines. raylib sends the batch in a single draw.
+    rlBegin(RL_LINES);
+        rlColor4ub(DARKGRAY.r, DARKGRAY.g, DARKGRAY.b, DARKGRAY.a);
+        for (int i = 0; i < GRID_LINE_VERTICES; i++) {
+            if (i == GRID_BOX_VERTICES) rlColor4ub(LIGHTGRAY.r, LIGHTGRAY.g, LIGHTGRAY.b, LIGHTGRAY.a);
+            rlVertex3f(gridLineVertices[i].x, gridLineVertices[i].y, gridLineVertices[i].z);
+        }
+    rlEnd();
 
+    // Highlight the hovered empty cell on top of the grid
+    if (hoverL != -1 && board[hoverL][hoverR][hoverC] == EMPTY) {
+        Vector3 cellCenter = GetCellCenter(hoverL, hoverR, hoverC);
+        DrawCubeWiresV(cellCenter, (Vector3){CELL_SIZE_3D, CELL_SIZE_3D, CELL_SIZE_3D}, YELLOW);
+        DrawCubeV(cellCenter, (Vector3){CELL_SIZE_3D, CELL_SIZE_3D, CELL_SIZE_3D}, Fade(YELLOW, 0.2f)); // Slightly stronger hover fill
+    }
 
-    // Draw individual cell outlines and markers
+    // Gather marker transforms by symbol; an X is its bar model drawn at +45 and -45 degrees
+    Matrix xTransforms[2 * SIZE * SIZE * SIZE], oTransforms[SIZE * SIZE * SIZE];
+    int xCount = 0, oCount = 0;
+    Matrix flipX = MatrixRotateZ(-90*DEG2RAD); // Turns the +45 degree bar into the -45 degree one
     for (int l = 0; l < SIZE; l++) {
         for (int r = 0; r < SIZE; r++) {
             for (int c = 0; c < SIZE; c++) {
+                if (board[l][r][c] == EMPTY) continue;
                 Vector3 cellCenter = GetCellCenter(l, r, c);
-                Color cellColor = LIGHTGRAY;
-                bool isHovered = (l == hoverL && r == hoverR && c == hoverC);
-
-                // Draw the cell wireframe (cube)
-                if (isHovered && board[l][r][c] == EMPTY) {
-                    cellColor = YELLOW;
-                    DrawCubeWiresV(cellCenter, (Vector3){CELL_SIZE_3D, CELL_SIZE_3D, CELL_SIZE_3D}, cellColor);
-                    DrawCubeV(cellCenter, (Vector3){CELL_SIZE_3D, CELL_SIZE_3D, CELL_SIZE_3D}, Fade(YELLOW, 0.2f)); // Slightly stronger hover fill
+                Matrix place = MatrixTranslate(cellCenter.x, cellCenter.y, cellCenter.z);
+                if (board[l][r][c] == 'X') {
+                    xTransforms[xCount++] = MatrixMultiply(xModel.transform, place);
+                    xTransforms[xCount++] = MatrixMultiply(MatrixMultiply(xModel.transform, flipX), place);
                 } else {
-                    DrawCubeWiresV(cellCenter, (Vector3){CELL_SIZE_3D, CELL_SIZE_3D, CELL_SIZE_3D}, cellColor);
-                }
-
-                // Draw the player marker (X or O) if the cell is not empty
-                if (board[l][r][c] != EMPTY) {
-                    Color symbolColor = (board[l][r][c] == USER_SYMBOL) ? BLUE : RED;
-                    if (board[l][r][c] == 'X') {
-                        // Draw X using basic DrawCubeV with transformations
-                        float length = MARKER_CUBE_SIZE * 1.4f; // Make bars slightly longer to intersect nicely
-                        float thick = MARKER_CUBE_SIZE * 0.15f;
-                        Vector3 size = { length, thick, thick };
-
-                        rlPushMatrix(); // Save current matrix state
-                            rlTranslatef(cellCenter.x, cellCenter.y, cellCenter.z); // Move to cell center
-                            rlRotatef(45.0f, 0.0f, 0.0f, 1.0f); // Rotate for first bar
-                            DrawCubeV((Vector3){0,0,0}, size, symbolColor); // Draw centered at origin
-                            DrawCubeWiresV((Vector3){0,0,0}, size, ColorAlpha(symbolColor, 0.7f));
-                        rlPopMatrix(); // Restore matrix state
-
-                        rlPushMatrix(); // Save current matrix state again
-                            rlTranslatef(cellCenter.x, cellCenter.y, cellCenter.z); // Move to cell center
-                            rlRotatef(-45.0f, 0.0f, 0.0f, 1.0f); // Rotate for second bar
-                            DrawCubeV((Vector3){0,0,0}, size, symbolColor); // Draw centered at origin
-                            DrawCubeWiresV((Vector3){0,0,0}, size, ColorAlpha(symbolColor, 0.7f));
-                        rlPopMatrix(); // Restore matrix state
-
-                    } else { // Symbol is 'O'
-                        DrawSphere(cellCenter, MARKER_RADIUS, symbolColor);
-                        DrawSphereWires(cellCenter, MARKER_RADIUS, 16, 16, ColorAlpha(symbolColor, 0.5f)); // Increased segments for smoother sphere wires
-                    }
+                    oTransforms[oCount++] = MatrixMultiply(oModel.transform, place);
                 }
             }
         }
     }
+
+    // One instanced draw per symbol, colored by owner as before
+    if (xCount > 0) {
+        xModel.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = ('X' == USER_SYMBOL) ? BLUE : RED;
+        DrawMeshInstanced(xModel.meshes[0], xModel.materials[0], xTransforms, xCount);
+    }
+    if (oCount > 0) {
+        oModel.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = ('O' == USER_SYMBOL) ? BLUE : RED;
+        DrawMeshInstanced(oModel.meshes[0], oModel.materials[0], oTransforms, oCount);
+    }
     // Draw the winning line if applicable
     if(drawWinningLine) {
         float thickness = 0.2f + sinf(timeCounter*8)*0.1f;
@@ -835,6 +693,12 @@ void DrawUI(GameScreen currentScreen, char winner, Font font, int difficulty, ch
             pos.y += 30;
             DrawTextEx(font, TextFormat("TURN: %c", (currentScreen == PLAYER_TURN) ? USER_SYMBOL : AI_SYMBOL), 
                       pos, fontSize, spacing, WHITE);
+            if (currentScreen == AI_THINKING) {
+                pos.y += 30;
+                int dots = (int)(timeCounter * 3) % 4; // Animated while the worker searches
+                DrawTextEx(font, TextFormat("AI THINKING%.*s", dots, "..."), pos, fontSize, spacing,
+                          ColorAlpha(O_COLOR, 0.7f + sinf(timeCounter*6)*0.3f));
+            }
             break;
     }
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+// Headless 3D Tic-Tac-Toe: the engine behind the UCI-like text protocol (see textProtocol.h)
+//
+// Moves are three digits, layer, row and column, each 0-2: "111" is the center cube.
+// 'X' moves first; the engine always plays the side to move.
+
+#include <stdio.h>
+#include "engine/threeDTicTacToeEngine.h"
+#include "textProtocol.h"
+
+char board[SIZE][SIZE][SIZE];
+
+static void newGame(void) {
+    InitializeBoard3D(board);
+}
+
+static bool setPosition(char **moves, int count) {
+    InitializeBoard3D(board);
+    char side = 'X';
+    for (int i = 0; i < count; i++) {
+        const char *m = moves[i];
+        if (strlen(m) != 3) return false;
+        int layer = m[0] - '0', row = m[1] - '0', col = m[2] - '0';
+        if (!IsValidMove(board, layer, row, col) || CheckWinner3D(board) != EMPTY) return false;
+        board[layer][row][col] = side;
+        side = (side == 'X') ? 'O' : 'X';
+    }
+    AI_SYMBOL = side;
+    USER_SYMBOL = (side == 'X') ? 'O' : 'X';
+    return true;
+}
+
+static int search(const SearchLimits *limits, SearchInfoCallback onInfo, void *ctx) {
+    if (CheckWinner3D(board) != EMPTY || IsBoardFull(board)) return -1;
+    int layer, row, col;
+    GetAIMoveLimited(board, limits, onInfo, ctx, &layer, &row, &col);
+    return layer == -1 ? -1 : layer * 9 + row * 3 + col;
+}
+
+static void formatMove(int move, char out[16]) {
+    snprintf(out, 16, "%d%d%d", move / 9, (move / 3) % 3, move % 3);
+}
+
+static void printBoard(void) {
+    for (int layer = 0; layer < SIZE; layer++) {
+        printf("Layer %d:\n", layer);
+        for (int row = 0; row < SIZE; row++) {
+            printf(" %c | %c | %c\n", board[layer][row][0], board[layer][row][1], board[layer][row][2]);
+        }
+    }
+    printf("%c to move\n", AI_SYMBOL);
+}
+
+int main(void) {
+    TextProtocolGame game = { "threeDTicTacToe", newGame, setPosition, search, formatMove, printBoard, NULL };
+    runTextProtocol(&game);
+    return 0;
+}
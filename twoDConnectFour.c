@@ -1,16 +1,11 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <limits.h>
 #include <stdbool.h>
 #include <string.h>
 #include "include/raylib.h" // Include Raylib
-
-// Define constants
-#define ROWS 6
-#define COLS 7
-#define PLAYER 1
-#define AI 2
-#define EMPTY 0
+#include "engine/twoDConnectFourEngine.h" // Board, rules and AI
+#include "engine/cpuCount.h" // Search threads per core
+#include "searchStatsOverlay.h" // F3 overlay and log of the AI's last search
 
 // Raylib drawing constants
 #define SCREEN_WIDTH 700
@@ -21,11 +16,8 @@
 #define BOARD_OFFSET_X 0
 #define BOARD_OFFSET_Y 100 // Offset board down to make space for messages
 
-// Global variable for difficulty (could be made local)
-int difficulty = 4; // Default difficulty
-
-// Define the 2D board
-int board[ROWS][COLS];
+// The game's position. The engine never reads it directly; the AI searches a copy.
+Board2D board;
 
 // Game state enum
 typedef enum {
@@ -40,169 +32,12 @@ GameState currentState;
 bool gameOver;
 char message[150]; // Increased size for restart message
 int winner;
+SearchStats aiStats; // The AI's last search, for the overlay
 
 // Forward declarations for functions used before definition
-bool isFull2D();
 void drawBoardRaylib(const char* message, GameState currentState); // Updated signature
 void drawDifficultySelection(); // New drawing function for selection screen
 void resetGame(); // Added forward declaration
-int getBestMove2D();
-int minimax2D(int depth, int alpha, int beta, bool maximizing);
-int evaluateBoard2D();
-bool winningMove2D(int piece);
-void undoMove2D(int col);
-int makeMove2D(int col, int piece);
-bool isValidMove2D(int col);
-
-
-// ----------------------- 2D CONNECT 4 FUNCTIONS -----------------------
-
-bool isValidMove2D(int col) {
-    return col >= 0 && col < COLS && board[0][col] == EMPTY;
-}
-
-int makeMove2D(int col, int piece) {
-    for (int r = ROWS - 1; r >= 0; r--) {
-        if (board[r][col] == EMPTY) {
-            board[r][col] = piece;
-            return r;
-        }
-    }
-    return -1;
-}
-
-void undoMove2D(int col) {
-    for (int r = 0; r < ROWS; r++) {
-        if (board[r][col] != EMPTY) {
-            board[r][col] = EMPTY;
-            break;
-        }
-    }
-}
-
-bool winningMove2D(int piece) {
-    // Horizontal
-    for (int r = 0; r < ROWS; r++)
-        for (int c = 0; c < COLS - 3; c++)
-            if (board[r][c] == piece && board[r][c+1] == piece && board[r][c+2] == piece && board[r][c+3] == piece)
-                return true;
-    // Vertical
-    for (int c = 0; c < COLS; c++)
-        for (int r = 0; r < ROWS - 3; r++)
-            if (board[r][c] == piece && board[r+1][c] == piece && board[r+2][c] == piece && board[r+3][c] == piece)
-                return true;
-    // Positive Diagonal
-    for (int r = 0; r < ROWS - 3; r++)
-        for (int c = 0; c < COLS - 3; c++)
-            if (board[r][c] == piece && board[r+1][c+1] == piece && board[r+2][c+2] == piece && board[r+3][c+3] == piece)
-                return true;
-    // Negative Diagonal
-    for (int r = 3; r < ROWS; r++)
-        for (int c = 0; c < COLS - 3; c++)
-            if (board[r][c] == piece && board[r-1][c+1] == piece && board[r-2][c+2] == piece && board[r-3][c+3] == piece)
-                return true;
-    return false;
-}
-
-int evaluateBoard2D() {
-    if (winningMove2D(AI)) return 100;
-    if (winningMove2D(PLAYER)) return -100;
-    return 0;
-}
-
-int minimax2D(int depth, int alpha, int beta, bool maximizing) {
-    if (winningMove2D(PLAYER)) return -100 - depth;
-    if (winningMove2D(AI)) return 100 + depth;
-    if (isFull2D()) return 0;
-    if (depth == 0) return evaluateBoard2D();
-
-    if (maximizing) {
-        int maxEval = INT_MIN;
-        for (int c = 0; c < COLS; c++) {
-            if (isValidMove2D(c)) {
-                makeMove2D(c, AI);
-                int eval = minimax2D(depth - 1, alpha, beta, false);
-                undoMove2D(c);
-                maxEval = eval > maxEval ? eval : maxEval;
-                alpha = alpha > eval ? alpha : eval;
-                if (beta <= alpha)
-                    break;
-            }
-        }
-        return maxEval;
-    } else {
-        int minEval = INT_MAX;
-        for (int c = 0; c < COLS; c++) {
-            if (isValidMove2D(c)) {
-                makeMove2D(c, PLAYER);
-                int eval = minimax2D(depth - 1, alpha, beta, true);
-                undoMove2D(c);
-                minEval = eval < minEval ? eval : minEval;
-                beta = beta < eval ? beta : eval;
-                if (beta <= alpha)
-                    break;
-            }
-        }
-        return minEval;
-    }
-}
-
-int getBestMove2D() {
-    int bestScore = INT_MIN;
-    int bestCol = -1;
-
-    // Prioritize center column slightly if available initially (simple heuristic)
-    if (isValidMove2D(COLS / 2)) {
-        bestCol = COLS / 2;
-    }
-
-    for (int c = 0; c < COLS; c++) {
-        if (isValidMove2D(c)) {
-            // Check for immediate AI win
-            makeMove2D(c, AI);
-            if (winningMove2D(AI)) {
-                undoMove2D(c);
-                return c; // Immediate win is the best move
-            }
-            undoMove2D(c);
-
-            // Evaluate the move using minimax
-            makeMove2D(c, AI);
-            // We call minimax for the minimizing player (false) because it's evaluating the state *after* AI moves,
-            // anticipating the player's response.
-            int score = minimax2D(difficulty, INT_MIN, INT_MAX, false);
-            undoMove2D(c);
-
-            // Update best move found so far
-            if (bestCol == -1 || score > bestScore) { // If it's the first valid move checked OR score is better
-                bestScore = score;
-                bestCol = c;
-            }
-        }
-    }
-
-    // If no move was found (should only happen if board is full at start, which is impossible)
-    // or if all moves lead to immediate loss (minimax returns very low scores),
-    // pick the first valid one found initially or during the loop.
-    // If bestCol is still -1 after the loop, find the first available column as a fallback.
-    if (bestCol == -1) {
-        for (int c = 0; c < COLS; c++) {
-            if (isValidMove2D(c)) {
-                bestCol = c;
-                break;
-            }
-        }
-    }
-
-    return bestCol;
-}
-
-bool isFull2D() {
-    for (int c = 0; c < COLS; c++)
-        if (board[0][c] == EMPTY)
-            return false;
-    return true;
-}
 
 // ----------------------- RAYLIB DRAWING FUNCTIONS -----------------------
 
@@ -246,9 +81,10 @@ void drawBoardRaylib(const char* message, GameState currentState) { // Added cur
                 DrawCircle(x + CELL_SIZE / 2, y + CELL_SIZE / 2, PIECE_RADIUS, LIGHTGRAY);
 
                 // Draw pieces
-                if (board[r][c] == PLAYER) {
+                int piece = cellAt2D(&board, r, c);
+                if (piece == PLAYER) {
                     DrawCircle(x + CELL_SIZE / 2, y + CELL_SIZE / 2, PIECE_RADIUS, RED);
-                } else if (board[r][c] == AI) {
+                } else if (piece == AI) {
                     DrawCircle(x + CELL_SIZE / 2, y + CELL_SIZE / 2, PIECE_RADIUS, YELLOW);
                 }
                  // Draw grid lines
@@ -257,6 +93,12 @@ void drawBoardRaylib(const char* message, GameState currentState) { // Added cur
         }
         // Display game message (whose turn, win/loss/draw)
         DrawText(message, 10, 10, 40, BLACK);
+        // Live search progress while the background worker thinks
+        if (currentState == AI_TURN && aiWorker2D.running) {
+            DrawText(TextFormat("Depth %d  |  %lld nodes", atomic_load(&aiWorker2D.progress.depth),
+                                (long long)atomic_load(&aiWorker2D.progress.nodes)), 10, 60, 20, DARKGRAY);
+        }
+        drawSearchStats(&aiStats, 10, BOARD_OFFSET_Y + 10, BLACK, RAYWHITE);
     } else {
         // If in difficulty selection state, call its specific drawing function
         drawDifficultySelection();
@@ -265,7 +107,8 @@ void drawBoardRaylib(const char* message, GameState currentState) { // Added cur
 
 // Function to reset the game state
 void resetGame() {
-    memset(board, EMPTY, sizeof(board));
+    stopAIWorker();
+    memset(&board, 0, sizeof(board));
     currentState = DIFFICULTY_SELECTION;
     gameOver = false;
     winner = EMPTY;
@@ -280,6 +123,10 @@ int main() {
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "2D Connect Four - Raylib");
     SetTargetFPS(60);
 
+    initZobrist2D();
+    initTT2D(TT_DEFAULT_SIZE_LOG2);
+    searchThreads = onlineCpuCount(COLS); // One search thread per core, but no more than root moves
+
     // Initialize game state (now uses global variables)
     resetGame(); // Initialize state using reset function
 
@@ -295,15 +142,15 @@ int main() {
                 Rectangle hardButton = { SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 90, 200, 50 };
 
                 if (CheckCollisionPointRec(mousePoint, easyButton)) {
-                    difficulty = 2; // Easy
+                    difficulty2D = 2; // Easy
                     currentState = PLAYER_TURN;
                     strcpy(message, "Player's Turn (Click Column)");
                 } else if (CheckCollisionPointRec(mousePoint, mediumButton)) {
-                    difficulty = 4; // Medium
+                    difficulty2D = 4; // Medium
                     currentState = PLAYER_TURN;
                     strcpy(message, "Player's Turn (Click Column)");
                 } else if (CheckCollisionPointRec(mousePoint, hardButton)) {
-                    difficulty = 6; // Hard
+                    difficulty2D = ROWS * COLS; // Hard: as deep as moveTimeMs2D allows
                     currentState = PLAYER_TURN;
                     strcpy(message, "Player's Turn (Click Column)");
                 }
@@ -318,14 +165,14 @@ int main() {
                         GetMouseY() >= BOARD_OFFSET_Y && GetMouseY() < BOARD_OFFSET_Y + ROWS * CELL_SIZE) {
                         int col = (mouseX - BOARD_OFFSET_X) / CELL_SIZE;
 
-                        if (isValidMove2D(col)) {
-                            makeMove2D(col, PLAYER);
-                            if (winningMove2D(PLAYER)) {
+                        if (isValidMove2D(&board, col)) {
+                            makeMove2D(&board, col, PLAYER);
+                            if (winningMove2D(&board, PLAYER)) {
                                 gameOver = true;
                                 winner = PLAYER;
                                 strcpy(message, "You Win!");
                                 currentState = GAME_OVER; // Explicitly set game over state
-                            } else if (isFull2D()) {
+                            } else if (isFull2D(&board)) {
                                 gameOver = true;
                                 winner = 3; // Draw
                                 strcpy(message, "Draw!");
@@ -343,22 +190,30 @@ int main() {
                 }
             } else if (currentState == AI_TURN) {
                 strcpy(message, "AI Thinking...");
-                // AI's move (consider adding a small delay for visual effect if desired)
-                // Draw frame before AI move calculation to show "Thinking..."
-                BeginDrawing();
-                ClearBackground(RAYWHITE);
-                drawBoardRaylib(message, currentState); // Pass current state
-                EndDrawing();
+                // The search runs on a worker thread; this branch only polls it, so the
+                // window keeps drawing at full frame rate while the AI thinks.
+                int aiCol = -1;
+                bool aiReady = false;
+                if (!aiWorker2D.running && !startAIWorker(&board)) {
+                    // No thread available: search synchronously as a fallback
+                    SearchProgress2D progress = { 0 };
+                    aiCol = getBestMove2D(&board, &progress);
+                    aiStats = progress.stats;
+                    aiReady = true;
+                } else if (pollAIWorker(&aiCol)) {
+                    aiStats = aiWorker2D.progress.stats; // The worker has been joined
+                    aiReady = true;
+                }
 
-                int aiCol = getBestMove2D();
-                 if (aiCol != -1) { // Ensure a valid move was found
-                    makeMove2D(aiCol, AI);
-                    if (winningMove2D(AI)) {
+                if (aiReady && aiCol != -1) { // Ensure a valid move was found
+                    makeMove2D(&board, aiCol, AI);
+                    logSearchStats("twoDConnectFour", &aiStats);
+                    if (winningMove2D(&board, AI)) {
                         gameOver = true;
                         winner = AI;
                         strcpy(message, "AI Wins!");
                         currentState = GAME_OVER; // Explicitly set game over state
-                    } else if (isFull2D()) {
+                    } else if (isFull2D(&board)) {
                         gameOver = true;
                         winner = 3; // Draw
                         strcpy(message, "Draw!");
@@ -367,10 +222,10 @@ int main() {
                         currentState = PLAYER_TURN;
                         // Message will be updated at the start of PLAYER_TURN block
                     }
-                 } else {
+                 } else if (aiReady) {
                      // This case should ideally not happen if isFull2D is checked correctly
                      // but as a fallback:
-                     if (isFull2D()) {
+                     if (isFull2D(&board)) {
                          gameOver = true;
                          winner = 3; // Draw
                          strcpy(message, "Draw! (AI found no moves)");
@@ -407,6 +262,8 @@ int main() {
     }
 
     // De-Initialization
+    stopAIWorker();
+    freeTT2D();
     CloseWindow();
 
     return 0;
@@ -0,0 +1,61 @@
+// Headless 2D Connect Four: the engine behind the UCI-like text protocol (see textProtocol.h)
+//
+// A move is the column, 0-6. The engine always plays the side to move, as AI.
+
+#include <stdio.h>
+#include "engine/twoDConnectFourEngine.h"
+#include "textProtocol.h"
+
+Board2D board;
+
+static void newGame(void) {
+    clearTT2D();
+}
+
+static bool setPosition(char **moves, int count) {
+    memset(&board, 0, sizeof(board));
+    for (int i = 0; i < count; i++) {
+        // Pieces alternate so that AI is the side to move after the last one
+        int piece = (count - i) % 2 == 0 ? AI : PLAYER;
+        int col = moves[i][0] - '0';
+        if (moves[i][1] != '\0' || !isValidMove2D(&board, col) ||
+            winningMove2D(&board, AI) || winningMove2D(&board, PLAYER)) return false;
+        makeMove2D(&board, col, piece);
+    }
+    return true;
+}
+
+static int search(const SearchLimits *limits, SearchInfoCallback onInfo, void *ctx) {
+    if (winningMove2D(&board, AI) || winningMove2D(&board, PLAYER) || isFull2D(&board)) return -1;
+    return getBestMove2DLimited(&board, limits, onInfo, ctx);
+}
+
+static void formatMove(int move, char out[16]) {
+    snprintf(out, 16, "%d", move);
+}
+
+// Side to move as 'x', the other side as 'o'
+static void printBoard(void) {
+    for (int r = ROWS - 1; r >= 0; r--) {
+        for (int c = 0; c < COLS; c++) {
+            int piece = cellAt2D(&board, r, c);
+            printf("|%c", piece == AI ? 'x' : piece == PLAYER ? 'o' : ' ');
+        }
+        printf("|\n");
+    }
+    for (int c = 0; c < COLS; c++) printf(" %d", c);
+    printf("\n");
+}
+
+static void setThreads(int threads) {
+    searchThreads = threads < 1 ? 1 : threads > COLS ? COLS : threads;
+}
+
+int main(void) {
+    initZobrist2D();
+    initTT2D(TT_DEFAULT_SIZE_LOG2);
+    TextProtocolGame game = { "twoDConnectFour", newGame, setPosition, search, formatMove, printBoard, setThreads };
+    runTextProtocol(&game);
+    freeTT2D();
+    return 0;
+}
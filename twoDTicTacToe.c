@@ -1,11 +1,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
-#include <limits.h>
 #include <stdbool.h> // Added for bool type
 #include "include/raylib.h" // Added for Raylib
-
-#define SIZE 3
+#include "engine/twoDTicTacToeEngine.h" // Board, rules and AI
+#include "searchStatsOverlay.h" // F3 overlay and log of the AI's last search
 
 // --- Raylib Specific Defines ---
 #define SCREEN_WIDTH 600
@@ -23,11 +22,6 @@
 #define HOVER_COLOR Fade(YELLOW, 0.3f)
 #define BACKGROUND_COLOR RAYWHITE
 
-char board[SIZE][SIZE];
-int difficulty = 3; // Default to hard
-char playerSymbol = ' '; // Player selects X or O
-char aiSymbol = ' ';
-
 // Game State Enum
 typedef enum {
     SELECT_SYMBOL,      // New state for symbol selection
@@ -38,193 +32,9 @@ typedef enum {
 } GameScreen;
 
 // --- Function Declarations ---
-void InitializeBoard();
-// void printBoard(); // Replaced by DrawBoard2D
-int IsMovesLeft();
-char CheckWinner();
-int Evaluate();
-int AlphaBeta(int depth, bool isMax, int alpha, int beta, int maxDepth); // Changed isMax to bool
-void FindBestMove(int *bestRow, int *bestCol);
-void MakeRandomMove(int *row, int *col);
-void AIMove();
 void DrawBoard2D(int hoverRow, int hoverCol); // Added hover parameters
 void DrawUI(GameScreen currentScreen, char winner, Font font); // Added UI function
 
-// --- Game Logic Functions (Mostly Unchanged) ---
-
-void InitializeBoard() {
-    for (int i = 0; i < SIZE; i++)
-        for (int j = 0; j < SIZE; j++)
-            board[i][j] = ' ';
-}
-
-int IsMovesLeft() {
-    for (int i = 0; i < SIZE; i++)
-        for (int j = 0; j < SIZE; j++)
-            if (board[i][j] == ' ')
-                return 1;
-    return 0;
-}
-
-char CheckWinner() {
-    // Rows and Columns
-    for (int i = 0; i < SIZE; i++) {
-        if (board[i][0] != ' ' && board[i][0] == board[i][1] && board[i][1] == board[i][2]) return board[i][0];
-        if (board[0][i] != ' ' && board[0][i] == board[1][i] && board[1][i] == board[2][i]) return board[0][i];
-    }
-    // Diagonals
-    if (board[0][0] != ' ' && board[0][0] == board[1][1] && board[1][1] == board[2][2]) return board[0][0];
-    if (board[0][2] != ' ' && board[0][2] == board[1][1] && board[1][1] == board[2][0]) return board[0][2];
-
-    return ' '; // No winner
-}
-
-int Evaluate() {
-    char winner = CheckWinner();
-    if (winner == aiSymbol) return 10;      // Use aiSymbol
-    else if (winner == playerSymbol) return -10; // Use playerSymbol
-    return 0; // Draw or ongoing
-}
-
-// Minimax with Alpha-Beta Pruning (changed isMax to bool)
-int AlphaBeta(int depth, bool isMax, int alpha, int beta, int maxDepth) {
-    int score = Evaluate();
-
-    // Terminal states
-    if (score == 10) return score - depth; // AI wins
-    if (score == -10) return score + depth; // Human wins
-    if (!IsMovesLeft() || depth >= maxDepth) return 0; // Draw or depth limit
-
-    if (isMax) { // AI's turn (Maximizer)
-        int best = INT_MIN;
-        for (int i = 0; i < SIZE; i++) {
-            for (int j = 0; j < SIZE; j++) {
-                if (board[i][j] == ' ') {
-                    board[i][j] = aiSymbol; // Use aiSymbol
-                    int val = AlphaBeta(depth + 1, false, alpha, beta, maxDepth);
-                    best = (best > val) ? best : val;
-                    alpha = (alpha > best) ? alpha : best;
-                    board[i][j] = ' '; // Undo move
-                    if (beta <= alpha) return best; // Prune
-                }
-            }
-        }
-        return best;
-    } else { // Human's turn (Minimizer)
-        int best = INT_MAX;
-        for (int i = 0; i < SIZE; i++) {
-            for (int j = 0; j < SIZE; j++) {
-                if (board[i][j] == ' ') {
-                    board[i][j] = playerSymbol; // Use playerSymbol
-                    int val = AlphaBeta(depth + 1, true, alpha, beta, maxDepth);
-                    best = (best < val) ? best : val;
-                    beta = (beta < best) ? beta : best;
-                    board[i][j] = ' '; // Undo move
-                    if (beta <= alpha) return best; // Prune
-                }
-            }
-        }
-        return best;
-    }
-}
-
-void FindBestMove(int *bestRow, int *bestCol) {
-    int bestVal = INT_MIN;
-    *bestRow = -1;
-    *bestCol = -1;
-    // Adjust maxDepth based on difficulty (more moves explored for harder levels)
-    int maxDepth = (difficulty == 1) ? 1 : (difficulty == 2) ? 3 : 9;
-
-    // --- Randomness for equivalent best moves ---
-    typedef struct { int r, c; } Move;
-    Move bestMoves[SIZE*SIZE];
-    int numBestMoves = 0;
-    // --- End Randomness ---
-
-
-    for (int i = 0; i < SIZE; i++) {
-        for (int j = 0; j < SIZE; j++) {
-            if (board[i][j] == ' ') {
-                board[i][j] = aiSymbol; // Use aiSymbol
-                // Use AlphaBeta directly here for evaluation
-                int moveVal = AlphaBeta(0, false, INT_MIN, INT_MAX, maxDepth);
-                board[i][j] = ' '; // Undo move
-
-                if (moveVal > bestVal) {
-                    bestVal = moveVal;
-                    // Reset best moves list
-                    numBestMoves = 0;
-                    bestMoves[numBestMoves++] = (Move){i, j};
-                } else if (moveVal == bestVal) {
-                    // Add to list of equally good moves
-                    if (numBestMoves < SIZE*SIZE) { // Basic bounds check
-                         bestMoves[numBestMoves++] = (Move){i, j};
-                    }
-                }
-            }
-        }
-    }
-
-    // Select randomly from the best moves found
-    if (numBestMoves > 0) {
-        int randomIndex = rand() % numBestMoves;
-        *bestRow = bestMoves[randomIndex].r;
-        *bestCol = bestMoves[randomIndex].c;
-    } else {
-        // Fallback: if no move evaluated (shouldn't happen if moves left), pick first available
-        for (int i = 0; i < SIZE; i++) {
-            for (int j = 0; j < SIZE; j++) {
-                if (board[i][j] == ' ') {
-                    *bestRow = i;
-                    *bestCol = j;
-                    return;
-                }
-            }
-        }
-    }
-}
-
-
-void MakeRandomMove(int *row, int *col) {
-    int emptyCells[SIZE * SIZE][2], count = 0;
-    for (int i = 0; i < SIZE; i++)
-        for (int j = 0; j < SIZE; j++)
-            if (board[i][j] == ' ') {
-                emptyCells[count][0] = i;
-                emptyCells[count][1] = j;
-                count++;
-            }
-    if (count > 0) {
-        int choice = rand() % count;
-        *row = emptyCells[choice][0];
-        *col = emptyCells[choice][1];
-    } else {
-        *row = -1; // Indicate no move possible
-        *col = -1;
-    }
-}
-
-void AIMove() {
-    int row = -1, col = -1;
-    if (difficulty == 1) { // Easy: Random move
-        MakeRandomMove(&row, &col);
-    } else { // Medium/Hard: Use Minimax (AlphaBeta)
-        FindBestMove(&row, &col);
-    }
-
-    // Ensure a valid move was found before placing
-    if (row != -1 && col != -1 && board[row][col] == ' ') {
-        board[row][col] = aiSymbol; // Use aiSymbol
-    } else if (IsMovesLeft()) {
-        // Fallback if AI logic failed but moves are available (should not happen often)
-        printf("AI Logic Error: Making random fallback move.\n"); // Corrected newline escape
-        MakeRandomMove(&row, &col);
-        if (row != -1 && col != -1) {
-             board[row][col] = aiSymbol; // Use aiSymbol
-        }
-    }
-}
-
 // --- Raylib Drawing Functions ---
 
 void DrawBoard2D(int hoverRow, int hoverCol) {
@@ -330,6 +140,7 @@ int main(void) {
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "2D Tic-Tac-Toe - Raylib");
     SetTargetFPS(60);
     srand(time(NULL)); // Seed random number generator
+    InitMoveTables(); // Solve the game once; AI moves are table lookups from here on
 
     // InitializeBoard(); // Board initialized after symbol/difficulty selection
     char winner = ' ';
@@ -395,6 +206,7 @@ int main(void) {
             case AI_TURN:
                 // AI makes its move
                 AIMove();
+                logSearchStats("twoDTicTacToe", &searchStats);
                 winner = CheckWinner();
                 if (winner != ' ' || !IsMovesLeft()) {
                     currentScreen = GAME_OVER;
@@ -426,6 +238,7 @@ int main(void) {
                 DrawBoard2D(hoverRow, hoverCol); // Draw the game board
             }
             DrawUI(currentScreen, winner, font); // Draw UI elements
+            drawSearchStats(&searchStats, PADDING, 45, DARKGRAY, RAYWHITE);
 
             // DrawFPS(10, 10); // Optional: Show FPS
 
@@ -0,0 +1,53 @@
+// Headless 2D Tic-Tac-Toe: the engine behind the UCI-like text protocol (see textProtocol.h)
+//
+// Moves are two digits, row then column, each 0-2: "11" is the center. 'X' moves first;
+// the engine always plays the side to move.
+
+#include <stdio.h>
+#include "engine/twoDTicTacToeEngine.h"
+#include "textProtocol.h"
+
+static void newGame(void) {
+    InitializeBoard();
+}
+
+static bool setPosition(char **moves, int count) {
+    InitializeBoard();
+    char side = 'X';
+    for (int i = 0; i < count; i++) {
+        const char *m = moves[i];
+        if (strlen(m) != 2 || m[0] < '0' || m[0] > '2' || m[1] < '0' || m[1] > '2') return false;
+        int row = m[0] - '0', col = m[1] - '0';
+        if (board[row][col] != ' ' || CheckWinner() != ' ') return false;
+        board[row][col] = side;
+        side = (side == 'X') ? 'O' : 'X';
+    }
+    aiSymbol = side;
+    playerSymbol = (side == 'X') ? 'O' : 'X';
+    return true;
+}
+
+static int search(const SearchLimits *limits, SearchInfoCallback onInfo, void *ctx) {
+    if (CheckWinner() != ' ' || !IsMovesLeft()) return -1;
+    int row, col;
+    FindBestMoveLimited(limits, onInfo, ctx, &row, &col);
+    return row == -1 ? -1 : row * SIZE + col;
+}
+
+static void formatMove(int move, char out[16]) {
+    snprintf(out, 16, "%d%d", move / SIZE, move % SIZE);
+}
+
+static void printBoard(void) {
+    for (int i = 0; i < SIZE; i++) {
+        printf(" %c | %c | %c\n", board[i][0], board[i][1], board[i][2]);
+        if (i < SIZE - 1) printf("---+---+---\n");
+    }
+    printf("%c to move\n", aiSymbol);
+}
+
+int main(void) {
+    TextProtocolGame game = { "twoDTicTacToe", newGame, setPosition, search, formatMove, printBoard, NULL };
+    runTextProtocol(&game);
+    return 0;
+}